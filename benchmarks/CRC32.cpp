@@ -0,0 +1,314 @@
+#include <CRC/CRC32.hpp>
+
+#include "CRC32-Kernels.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include <getopt.h>
+
+#if defined(_M_X64) || defined(__amd64__)
+#include <x86intrin.h>
+#endif
+
+// Measures each CRC32 kernel of the host on its own, rather than whichever
+// one Checksum would pick, so that a regression in any of them shows up
+
+static constexpr std::pair<const char*, CRC::Polynomial> PolynomialNames[] = {
+	{"crc32", CRC::Polynomial::CRC32},   {"crc32c", CRC::Polynomial::CRC32C},
+	{"crc32k", CRC::Polynomial::CRC32K}, {"crc32k2", CRC::Polynomial::CRC32K2},
+	{"crc32q", CRC::Polynomial::CRC32Q},
+};
+
+static const char* Usage
+	= "CRC32_bench - Measures each CRC32 kernel of this machine\n"
+	  "Usage: CRC32_bench [Options]...\n"
+	  "  -f, --format             Output format, csv(default) or json\n"
+	  "  -s, --max-size           Largest input size in bytes, from 1 byte\n"
+	  "                           up in powers of four, 1GiB(default)\n"
+	  "  -k, --kernel             Measure only this kernel\n"
+	  "  -p, --polynomial         Measure only this polynomial\n"
+	  "  -h, --help               Show this help message\n";
+
+static const struct option CommandOptions[]
+	= {{"format", required_argument, nullptr, 'f'},
+	   {"max-size", required_argument, nullptr, 's'},
+	   {"kernel", required_argument, nullptr, 'k'},
+	   {"polynomial", required_argument, nullptr, 'p'},
+	   {"help", no_argument, nullptr, 'h'},
+	   {nullptr, no_argument, nullptr, '\0'}};
+
+struct Result
+{
+	std::string_view Kernel;
+	const char*      Polynomial;
+	std::size_t      Size;
+	std::size_t      Offset;
+	bool             Chained;
+	double           GigabytesPerSecond;
+	// Reference cycles of the timestamp counter, which may tick at a different
+	// rate than the core clock. NaN upon hosts without one.
+	double CyclesPerByte;
+};
+
+static std::uint64_t ReadCycleCounter()
+{
+#if defined(_M_X64) || defined(__amd64__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+// Best of several batches, each of as many calls as fit in a few milliseconds.
+// Chained calls each continue from the checksum of the last, so that no call
+// may begin before the last has finished, as when checksumming a stream.
+// Otherwise each call starts over, so that calls upon small inputs may overlap.
+static Result MeasureKernel(
+	const CRC::ChecksumKernel& Kernel, CRC::Polynomial Poly,
+	std::span<const std::byte> Data, bool Chained)
+{
+	constexpr auto BatchTime = std::chrono::milliseconds(10);
+
+	// Find how many calls fill a batch
+	std::size_t Repeats = 1;
+	while( true )
+	{
+		const auto StartTime = std::chrono::steady_clock::now();
+		for( std::size_t i = 0; i < Repeats; ++i )
+		{
+			const std::uint32_t CRC = Kernel.Checksum(Data, 0, Poly);
+			__asm__ volatile("" : : "r"(CRC));
+		}
+		if( std::chrono::steady_clock::now() - StartTime >= BatchTime )
+		{
+			break;
+		}
+		Repeats *= 2;
+	}
+
+	double        BestTime   = std::numeric_limits<double>::infinity();
+	std::uint64_t BestCycles = 0;
+	for( std::size_t j = 0; j < 3; ++j )
+	{
+		std::uint32_t CRC = 0;
+
+		const auto          StartTime   = std::chrono::steady_clock::now();
+		const std::uint64_t StartCycles = ReadCycleCounter();
+		if( Chained )
+		{
+			for( std::size_t i = 0; i < Repeats; ++i )
+			{
+				CRC = Kernel.Checksum(Data, CRC, Poly);
+			}
+		}
+		else
+		{
+			for( std::size_t i = 0; i < Repeats; ++i )
+			{
+				CRC ^= Kernel.Checksum(Data, 0, Poly);
+			}
+		}
+		const std::uint64_t EndCycles = ReadCycleCounter();
+		const std::chrono::duration<double> Elapsed
+			= std::chrono::steady_clock::now() - StartTime;
+
+		// Keeps the checksums from being optimized away
+		__asm__ volatile("" : : "r"(CRC));
+
+		if( Elapsed.count() < BestTime )
+		{
+			BestTime   = Elapsed.count();
+			BestCycles = EndCycles - StartCycles;
+		}
+	}
+
+	// An empty input is measured as if it were one byte, for the overhead of
+	// each call
+	const double TotalBytes
+		= double(std::max<std::size_t>(Data.size(), 1)) * double(Repeats);
+
+	Result CurResult             = {};
+	CurResult.GigabytesPerSecond = TotalBytes / BestTime / 1e9;
+	CurResult.CyclesPerByte
+		= BestCycles ? double(BestCycles) / TotalBytes
+					 : std::numeric_limits<double>::quiet_NaN();
+	return CurResult;
+}
+
+static void PrintResult(const Result& CurResult, bool JSON, bool First)
+{
+	if( JSON )
+	{
+		std::printf(
+			"%s\n\t{\"kernel\": \"%.*s\", \"polynomial\": \"%s\", "
+			"\"size\": %zu, \"offset\": %zu, \"chained\": %s, "
+			"\"gbps\": %.4f, ",
+			First ? "" : ",", int(CurResult.Kernel.size()),
+			CurResult.Kernel.data(), CurResult.Polynomial, CurResult.Size,
+			CurResult.Offset, CurResult.Chained ? "true" : "false",
+			CurResult.GigabytesPerSecond);
+		if( std::isnan(CurResult.CyclesPerByte) )
+		{
+			std::printf("\"cycles_per_byte\": null}");
+		}
+		else
+		{
+			std::printf("\"cycles_per_byte\": %.4f}", CurResult.CyclesPerByte);
+		}
+	}
+	else
+	{
+		std::printf(
+			"%.*s,%s,%zu,%zu,%d,%.4f,", int(CurResult.Kernel.size()),
+			CurResult.Kernel.data(), CurResult.Polynomial, CurResult.Size,
+			CurResult.Offset, CurResult.Chained ? 1 : 0,
+			CurResult.GigabytesPerSecond);
+		if( !std::isnan(CurResult.CyclesPerByte) )
+		{
+			std::printf("%.4f", CurResult.CyclesPerByte);
+		}
+		std::printf("\n");
+	}
+	std::fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+	bool             JSON    = false;
+	std::size_t      MaxSize = std::size_t(1) << 30;
+	std::string_view KernelFilter;
+	std::string_view PolynomialFilter;
+
+	int Opt;
+	int OptionIndex;
+	while( (Opt = getopt_long(
+				argc, argv, "f:s:k:p:h", CommandOptions, &OptionIndex))
+		   != -1 )
+	{
+		switch( Opt )
+		{
+		case 'f':
+		{
+			if( std::strcmp(optarg, "json") == 0 )
+			{
+				JSON = true;
+			}
+			else if( std::strcmp(optarg, "csv") != 0 )
+			{
+				std::fprintf(stderr, "Invalid format \"%s\"\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		}
+		case 's':
+		{
+			const auto ParseResult = std::from_chars<std::size_t>(
+				optarg, optarg + std::strlen(optarg), MaxSize);
+			if( *ParseResult.ptr != '\0' || ParseResult.ec != std::errc() )
+			{
+				std::fprintf(stderr, "Invalid size \"%s\"\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		}
+		case 'k':
+		{
+			KernelFilter = optarg;
+			break;
+		}
+		case 'p':
+		{
+			PolynomialFilter = optarg;
+			break;
+		}
+		case 'h':
+		default:
+		{
+			std::puts(Usage);
+			return Opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+		}
+	}
+
+	// Inputs start either upon a cache line or just past one
+	constexpr std::size_t Offsets[] = {0, 1};
+	constexpr std::size_t Alignment = 64;
+
+	// Random bytes, so that no kernel can take any shortcuts
+	const std::size_t BufferSize = MaxSize + Alignment * 2;
+	const auto        Buffer     = std::make_unique<std::byte[]>(BufferSize);
+	std::mt19937_64   MersenneTwister;
+	for( std::size_t i = 0; i + 8 <= BufferSize; i += 8 )
+	{
+		const std::uint64_t Value = MersenneTwister();
+		std::memcpy(Buffer.get() + i, &Value, sizeof(Value));
+	}
+
+	std::byte* const Aligned = reinterpret_cast<std::byte*>(
+		(std::uintptr_t(Buffer.get()) + Alignment - 1) & ~(Alignment - 1));
+
+	if( JSON )
+	{
+		std::printf("[");
+	}
+	else
+	{
+		std::printf(
+			"kernel,polynomial,size,offset,chained,gbps,cycles_per_byte\n");
+	}
+
+	bool First = true;
+	for( const CRC::ChecksumKernel& CurKernel : CRC::GetChecksumKernels() )
+	{
+		if( !KernelFilter.empty() && CurKernel.Name != KernelFilter )
+		{
+			continue;
+		}
+		for( const auto& [PolynomialName, Poly] : PolynomialNames )
+		{
+			if( !PolynomialFilter.empty()
+				&& PolynomialName != PolynomialFilter )
+			{
+				continue;
+			}
+			for( std::size_t Size = 1; Size <= MaxSize; Size *= 4 )
+			{
+				for( const std::size_t Offset : Offsets )
+				{
+					for( const bool Chained : {false, true} )
+					{
+						Result CurResult = MeasureKernel(
+							CurKernel, Poly,
+							std::span(Aligned + Offset, Size), Chained);
+						CurResult.Kernel     = CurKernel.Name;
+						CurResult.Polynomial = PolynomialName;
+						CurResult.Size       = Size;
+						CurResult.Offset     = Offset;
+						CurResult.Chained    = Chained;
+						PrintResult(CurResult, JSON, First);
+						First = false;
+					}
+				}
+			}
+		}
+	}
+
+	if( JSON )
+	{
+		std::printf("\n]\n");
+	}
+	return EXIT_SUCCESS;
+}
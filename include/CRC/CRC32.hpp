@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <numeric>
 #include <span>
+#include <string>
+#include <string_view>
 
 #ifdef __x86_64__
 #include <x86intrin.h>
@@ -24,4 +26,99 @@ std::uint32_t Checksum(
 	std::span<const std::byte> Data, std::uint32_t InitialValue = 0u,
 	Polynomial Poly = Polynomial::CRC32);
 
+// Specialized for a polynomial known at compile time. Its tables and fold
+// constants are resolved ahead of time, with no dispatch upon the polynomial
+// at runtime. Where the host has several kernels, the most specialized of
+// them, whatever a profile from Calibrate chose, is picked upon the first call
+// and called indirectly from then on.
+template<Polynomial Poly>
+std::uint32_t
+	Checksum(std::span<const std::byte> Data, std::uint32_t InitialValue = 0u);
+
+extern template std::uint32_t Checksum<Polynomial::CRC32>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+extern template std::uint32_t Checksum<Polynomial::CRC32C>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+extern template std::uint32_t Checksum<Polynomial::CRC32K>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+extern template std::uint32_t Checksum<Polynomial::CRC32K2>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+extern template std::uint32_t Checksum<Polynomial::CRC32Q>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+
+// Computes the checksums of several independent inputs at once, interleaving
+// their work so that many small inputs are not each bound by latency.
+// Checksums must have room for as many values as there are Inputs.
+void Checksum(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t>                    Checksums,
+	Polynomial                                  Poly = Polynomial::CRC32);
+
+// Computes a single checksum over the concatenation of several Segments, such
+// as a header and its payload or the two halves of a wrapped ring-buffer,
+// without copying them together. Folding carries on across the boundaries of
+// each segment and is only reduced once, at the end.
+std::uint32_t ChecksumSegments(
+	std::span<const std::span<const std::byte>> Segments,
+	std::uint32_t InitialValue = 0u, Polynomial Poly = Polynomial::CRC32);
+
+// Computes a checksum incrementally, across any number of calls to Update.
+// The unreduced state of the folding kernels is carried from one update to the
+// next and only reduced upon Finalize, so that hashing data in chunks runs at
+// the same speed as hashing all of it at once.
+class Hasher
+{
+public:
+	explicit Hasher(
+		Polynomial Poly = Polynomial::CRC32, std::uint32_t InitialValue = 0u);
+
+	void Update(std::span<const std::byte> Data);
+
+	std::uint32_t Finalize() const;
+
+private:
+	Polynomial    Poly;
+	std::uint32_t CRC;
+#if defined(__x86_64__)
+	// Which of the folding kernels of the host Update uses, chosen upon
+	// construction by the kernel that Checksum uses for the largest inputs
+	std::uint8_t FoldKernel = 0;
+#endif
+
+#if defined(__x86_64__) || defined(__ARM_FEATURE_AES)
+	// 512 bits of folded input, not yet reduced
+	alignas(16) std::array<std::byte, 64> FoldState;
+
+	// Input too short to be folded yet, stored after 16 bytes of padding that
+	// the final reduction may read from but never uses
+	alignas(16) std::array<std::byte, 16 + 64> Carry;
+	std::size_t CarrySize = 0;
+#endif
+};
+
+// Computes the checksum of Length zero bytes, such as the holes of a sparse
+// file, in O(log(Length)) time without needing any of them in memory
+std::uint32_t ChecksumZeros(
+	std::uint64_t Length, std::uint32_t InitialValue = 0u,
+	Polynomial Poly = Polynomial::CRC32);
+
+// Combines the checksums of two adjacent spans of data into the checksum of
+// their concatenation, where LengthB is the size of the second span in bytes.
+// Runs in O(log(LengthB)) time, without touching any of the data.
+std::uint32_t Combine(
+	std::uint32_t CRCA, std::uint32_t CRCB, std::uint64_t LengthB,
+	Polynomial Poly = Polynomial::CRC32);
+
+// Measures each kernel that the host supports upon inputs of several sizes,
+// and has Checksum, and each Hasher constructed from then on, use the fastest
+// of them for each size. Returns these choices as a profile, to be given to
+// LoadProfile upon later runs rather than measuring all over again.
+std::string Calibrate();
+
+// Has Checksum, and each Hasher constructed from then on, use the kernels
+// chosen by a profile from Calibrate. Returns false, and changes nothing, if
+// the profile is malformed or was measured upon a processor other than the
+// host's.
+bool LoadProfile(std::string_view Profile);
+
 } // namespace CRC
\ No newline at end of file
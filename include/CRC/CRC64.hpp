@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace CRC
+{
+
+enum class Polynomial64 : std::uint64_t
+{
+	ECMA182 = 0xC96C5795D7870F42,
+	NVMe    = 0x9A6C9329AC4BC9B5,
+};
+
+std::uint64_t Checksum64(
+	std::span<const std::byte> Data, std::uint64_t InitialValue = 0u,
+	Polynomial64 Poly = Polynomial64::ECMA182);
+
+// Combines the checksums of two adjacent spans of data into the checksum of
+// their concatenation, where LengthB is the size of the second span in bytes.
+// Runs in O(log(LengthB)) time, without touching any of the data.
+std::uint64_t Combine64(
+	std::uint64_t CRCA, std::uint64_t CRCB, std::uint64_t LengthB,
+	Polynomial64 Poly = Polynomial64::ECMA182);
+
+} // namespace CRC
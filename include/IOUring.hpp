@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+// A minimal io_uring, for read requests alone, driven through the system calls
+// directly rather than by way of liburing. Only ever used by a single thread.
+class IOUring
+{
+public:
+	// Returns nullptr if the kernel lacks io_uring, or forbids its use
+	static std::unique_ptr<IOUring> Create(unsigned QueueDepth);
+
+	~IOUring();
+
+	IOUring(const IOUring&)            = delete;
+	IOUring& operator=(const IOUring&) = delete;
+
+	// Pins Buffers in memory for the kernel to read into directly, rather than
+	// mapping their pages upon each read. Returns false if the kernel refuses,
+	// in which case reads still work, just without registered buffers.
+	bool RegisterBuffers(std::span<const std::span<std::byte>> Buffers);
+
+	// Queues a read of Data.size() bytes at Offset of the file, to be sent to
+	// the kernel by the next call to Submit or WaitCompletion. BufferIndex is
+	// the registered buffer that holds Data, if any. Returns false if the queue
+	// is full.
+	bool QueueRead(
+		int FileHandle, std::span<std::byte> Data, std::uint64_t Offset,
+		std::uint64_t UserData, std::optional<unsigned> BufferIndex = {});
+
+	bool Submit();
+
+	struct Completion
+	{
+		std::uint64_t UserData;
+		// Bytes read, or a negated errno
+		std::int32_t Result;
+	};
+
+	// Submits any queued reads and waits for the next read to complete
+	std::optional<Completion> WaitCompletion();
+
+	// Withdraws the queued reads that have yet to be submitted, and waits upon
+	// all of those that have been, discarding their completions, so that the
+	// kernel writes to none of their buffers any longer. Returns false if the
+	// kernel could not be waited upon, leaving the ring of no further use.
+	bool Drain();
+
+	// Whether a Drain has failed, leaving reads in flight for good
+	bool IsFailed() const;
+
+private:
+	IOUring() = default;
+
+	bool Enter(unsigned MinComplete);
+
+	int RingHandle = -1;
+
+	void*       SQRing      = nullptr;
+	std::size_t SQRingSize  = 0;
+	void*       CQRing      = nullptr;
+	std::size_t CQRingSize  = 0;
+	void*       SQEntries   = nullptr;
+	std::size_t SQEntrySize = 0;
+
+	std::uint32_t* SQHead  = nullptr;
+	std::uint32_t* SQTail  = nullptr;
+	std::uint32_t  SQMask  = 0;
+	std::uint32_t* SQArray = nullptr;
+	std::uint32_t  SQCount = 0;
+
+	std::uint32_t* CQHead    = nullptr;
+	std::uint32_t* CQTail    = nullptr;
+	std::uint32_t  CQMask    = 0;
+	void*          CQEntries = nullptr;
+
+	// Queued, but not yet submitted to the kernel
+	std::uint32_t Unsubmitted = 0;
+	// Submitted to the kernel, but not yet completed and reaped
+	std::uint32_t InFlight = 0;
+
+	bool Failed = false;
+
+	bool BuffersRegistered = false;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace MD5
+{
+
+// MD5, as specified by RFC 1321, for the manifests written by md5sum. Each
+// block depends upon the last, so a single input is never hashed faster than
+// the scalar rounds allow, and speed comes from hashing several at once.
+
+using Digest128 = std::array<std::uint8_t, 16>;
+
+Digest128 Hash(std::span<const std::byte> Data);
+
+// Hashes several independent inputs at once, one in each lane of the widest
+// vector registers of the host. Digests must have room for as many values as
+// there are Inputs.
+void Hash(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<Digest128>                         Digests);
+
+// Computes a hash incrementally, across any number of calls to Update
+class Hasher
+{
+public:
+	Hasher();
+
+	void Update(std::span<const std::byte> Data);
+
+	Digest128 Finalize() const;
+
+private:
+	std::array<std::uint32_t, 4> State;
+
+	// Input too short to be a whole block yet
+	alignas(64) std::array<std::byte, 64> Buffer;
+	std::size_t   BufferSize  = 0;
+	std::uint64_t TotalLength = 0;
+};
+
+} // namespace MD5
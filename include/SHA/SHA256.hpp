@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace SHA
+{
+
+// SHA-256, as specified by FIPS 180-4, for the manifests written by sha256sum
+
+using Digest256 = std::array<std::uint8_t, 32>;
+
+Digest256 Hash256(std::span<const std::byte> Data);
+
+// Hashes several independent inputs at once, one in each lane of the widest
+// vector registers of the host, so that many small inputs are hashed in about
+// the time of one. Digests must have room for as many values as there are
+// Inputs.
+void Hash256(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<Digest256>                         Digests);
+
+// Computes a hash incrementally, across any number of calls to Update
+class Hasher
+{
+public:
+	Hasher();
+
+	void Update(std::span<const std::byte> Data);
+
+	Digest256 Finalize() const;
+
+private:
+	std::array<std::uint32_t, 8> State;
+
+	// Input too short to be a whole block yet
+	alignas(64) std::array<std::byte, 64> Buffer;
+	std::size_t   BufferSize  = 0;
+	std::uint64_t TotalLength = 0;
+};
+
+} // namespace SHA
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace XXH
+{
+
+// A non-cryptographic hash from the XXH3 family, for when compatibility with
+// the CRC of .sfv files is not needed. Hashes are those of the reference XXH3
+// implementation with its default secret and a seed of zero.
+
+struct Digest128
+{
+	std::uint64_t Low;
+	std::uint64_t High;
+
+	bool operator==(const Digest128&) const = default;
+};
+
+std::uint64_t Hash64(std::span<const std::byte> Data);
+
+Digest128 Hash128(std::span<const std::byte> Data);
+
+// Computes a hash incrementally, across any number of calls to Update. Both
+// hash widths share the same state, and either may be finalized from it.
+class Hasher
+{
+public:
+	Hasher();
+
+	void Update(std::span<const std::byte> Data);
+
+	std::uint64_t Finalize64() const;
+	Digest128     Finalize128() const;
+
+private:
+	alignas(64) std::array<std::uint64_t, 8> Acc;
+
+	// Input not yet accumulated. Once any input has been accumulated, the
+	// last 64 bytes of this buffer always hold the last stripe accumulated.
+	alignas(64) std::array<std::byte, 256> Buffer;
+	std::size_t BufferSize = 0;
+
+	// Index of the next stripe within the current block
+	std::size_t   StripeIndex = 0;
+	std::uint64_t TotalLength = 0;
+};
+
+} // namespace XXH
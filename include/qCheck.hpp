@@ -7,12 +7,57 @@
 
 #include <getopt.h>
 
+#include <CRC/CRC32.hpp>
+
+enum class HashAlgorithm
+{
+	// .sfv files, of CRC checksums of the selected polynomial
+	CRC,
+	// Tagged lines of "<Algorithm> (<File>) = <Hash>", as with "xxhsum --tag"
+	XXH3,
+	XXH128,
+	// Lines of "<Hash>  <File>", as with "sha256sum"
+	SHA256,
+	// Lines of "<Hash>  <File>", as with "md5sum"
+	MD5,
+};
+
+// How file data is read in to be hashed
+enum class IOMethod
+{
+	// Mapped into memory through a sliding window of 16 MiB at a time, each
+	// window prefetched with MADV_WILLNEED before it is hashed
+	MMap,
+	// Read into buffers by an io_uring of each worker, which hashes each buffer
+	// while the reads of the buffers after it are still in flight
+	IOUring,
+};
+
 struct Settings
 {
 	std::vector<std::filesystem::path> InputFiles;
-	std::size_t                        Threads = 2;
-	bool                               Verbose = true;
-	bool                               Check   = false;
+	std::size_t                        Threads    = 2;
+	bool                               Verbose    = true;
+	bool                               Check      = false;
+	CRC::Polynomial                    Polynomial = CRC::Polynomial::CRC32;
+	// Each file is read only once, and hashed with all of these from that read
+	std::vector<HashAlgorithm> Algorithms = {HashAlgorithm::CRC};
+	// Writes the manifest of each algorithm to a file of its own, named after
+	// this, rather than all of them to stdout
+	std::filesystem::path OutputPrefix;
+	// Measures the CRC kernels of this host anew, rather than using the
+	// choices cached from an earlier run
+	bool Calibrate = false;
+	// Falls back to MMap where io_uring is unavailable
+	IOMethod IO = IOMethod::MMap;
+	// Reads files with O_DIRECT, into buffers rather than mappings, so as not
+	// to fill the page cache. Files of file systems without it are read as
+	// usual.
+	bool Direct = false;
+	// Drops each page of a file from the page cache once it has been hashed,
+	// unless it was cached before being read, so as to leave the page cache as
+	// it was. Does nothing when reading directly.
+	bool Scrub = false;
 };
 
 extern const char* Usage;
@@ -20,8 +65,20 @@ extern const char* Usage;
 const static struct option CommandOptions[]
 	= {{"threads", required_argument, nullptr, 't'},
 	   {"check", no_argument, nullptr, 'c'},
+	   {"polynomial", required_argument, nullptr, 'p'},
+	   {"algorithm", required_argument, nullptr, 'a'},
+	   {"output", required_argument, nullptr, 'o'},
+	   {"io", required_argument, nullptr, 'i'},
+	   {"direct", no_argument, nullptr, 'd'},
+	   {"scrub", no_argument, nullptr, 's'},
+	   {"calibrate", no_argument, nullptr, 'C'},
 	   {"help", no_argument, nullptr, 'h'},
 	   {nullptr, no_argument, nullptr, '\0'}};
 
+// Has CRC checksums use the kernels chosen by the profile cached under
+// $XDG_CACHE_HOME, if there is one of this machine, or calibrates and caches a
+// new profile if asked to
+void LoadCRCProfile(const Settings& CurSettings);
+
 int CheckSFV(const Settings& CurSettings);
 int GenerateSFV(const Settings& CurSettings);
\ No newline at end of file
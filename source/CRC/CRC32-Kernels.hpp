@@ -0,0 +1,68 @@
+#pragma once
+#include <CRC32.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace CRC
+{
+
+// Checksum kernels operate upon the CRC register directly, without any
+// bit-inversion
+using ChecksumT = std::uint32_t (*)(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly);
+
+struct ChecksumKernel
+{
+	std::string_view Name;
+	ChecksumT        Checksum;
+};
+
+// Every kernel that the host supports, from the most portable to the most
+// specialized. The last of them is used for every input until a profile says
+// otherwise.
+std::span<const ChecksumKernel> GetChecksumKernels();
+
+// Names the vendor, model, and features of the host processor, so that a
+// profile is only ever trusted upon the processor that it was measured upon
+std::string GetHostIdentity();
+
+// Kernels are chosen by the size of their input, within classes that each
+// span a factor of four: up to 16 bytes, up to 64 bytes, and so on, with the
+// last class taking every input larger than 64 KiB
+inline constexpr std::size_t SizeClassCount = 8;
+
+constexpr std::size_t SizeClass(std::size_t Size)
+{
+	if( Size <= 16 )
+	{
+		return 0;
+	}
+	return std::min<std::size_t>(
+		(std::bit_width(Size - 1) - 3) / 2, SizeClassCount - 1);
+}
+
+// The kernel that Checksum uses for an input of Size bytes
+ChecksumT GetChecksumKernel(Polynomial Poly, std::size_t Size);
+
+// Finds the CRC register value that becomes CRC after taking in 32 zero bits.
+// Checksumming these four bytes from a zero register ends up at CRC, and so
+// prefixing them to a message (along with any number of zero bytes, which
+// leave a zero register unchanged) stands in for starting from CRC.
+inline std::uint32_t UnshiftCRC32(std::uint32_t CRC, Polynomial Poly)
+{
+	for( std::size_t i = 0; i < 32; ++i )
+	{
+		CRC = (CRC & 0x8000'0000u)
+				? ((CRC ^ std::uint32_t(Poly)) << 1) | 1u
+				: CRC << 1;
+	}
+	return CRC;
+}
+
+} // namespace CRC
@@ -1,6 +1,9 @@
 #if defined(__aarch64__)
 
 #include <CRC32.hpp>
+#include <cstring>
+
+#include "CRC32-Kernels.hpp"
 
 #include <arm_neon.h>
 
@@ -81,24 +84,6 @@ struct CRC32TableStatic
 	}
 };
 
-static const CRC32TableT& GetCRC32Table(Polynomial Poly)
-{
-	switch( Poly )
-	{
-	default:
-	case Polynomial::CRC32:
-		return CRC32TableStatic<Polynomial::CRC32>()();
-	case Polynomial::CRC32C:
-		return CRC32TableStatic<Polynomial::CRC32C>()();
-	case Polynomial::CRC32K:
-		return CRC32TableStatic<Polynomial::CRC32K>()();
-	case Polynomial::CRC32K2:
-		return CRC32TableStatic<Polynomial::CRC32K2>()();
-	case Polynomial::CRC32Q:
-		return CRC32TableStatic<Polynomial::CRC32Q>()();
-	}
-}
-
 consteval std::uint32_t BitReverse32(std::uint32_t Value)
 {
 	std::uint32_t Reversed = 0;
@@ -205,17 +190,162 @@ inline poly64x2_t
 }
 
 #if defined(__ARM_FEATURE_AES)
+// Sliding window of `tbl` indices. Sixteen indices loaded from an offset of
+// (16 - n) shift a vector left by n bytes, and from an offset of (16 + n) shift
+// it right by n bytes, with the vacated bytes set to zero.
+alignas(16) static constexpr std::array<std::uint8_t, 48> ByteShiftTable = {
+	// clang-format off
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	// clang-format on
+};
+
+inline uint8x16_t ByteShiftIndices(std::ptrdiff_t Offset)
+{
+	return vld1q_u8(ByteShiftTable.data() + Offset);
+}
+
+// Reduces a 128-bit fold accumulator into a 32-bit CRC
 template<std::uint32_t Polynomial>
-std::uint32_t CRC32_PMULL(std::span<const std::byte> Data, std::uint32_t CRC)
+inline std::uint32_t CRC32_PMULL_Barrett(poly64x2_t CRCVec0)
 {
-	poly64x2x4_t CRCVec
-		= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(Data.data()));
+	const poly64x2_t K3K4 = poly64x2_t{
+		KnConstant(16 + 4, Polynomial),
+		KnConstant(16 - 4, Polynomial),
+	};
 
-	Data = Data.subspan(64);
+	// Reduce 128 to 64
+	const uint64x2_t Zero = vdupq_n_u64(0);
+	{
+		const poly64x2_t MulHiLo = pmull_p64<1, 0>(CRCVec0, K3K4);
 
-	CRCVec.val[0]
-		= veorq_u64(CRCVec.val[0], vsetq_lane_s32(CRC, vdupq_n_s32(0), 0));
+		const poly64x2_t Upper64 = vextq_s8(CRCVec0, Zero, 8);
+
+		CRCVec0 = veorq_u64(Upper64, MulHiLo);
+
+		const poly64x2_t K5K0 = poly64x2_t{
+			KnConstant(8, Polynomial),
+			0ull,
+		};
+
+		const poly64x2_t Upper96 = vextq_s8(CRCVec0, Zero, 4);
+		const poly64x2_t Trunc32 = vsliq_n_u64(CRCVec0, Zero, 32);
+
+		const poly64x2_t MulLo = pmull_p64<0, 0>(Trunc32, K5K0);
+
+		CRCVec0 = veorq_u64(MulLo, Upper96);
+	}
+
+	// Reduce 64 to 32
+	{
+		const poly64x2_t Poly = poly64x2_t{
+			KnConstant(4, Polynomial) | 1,
+			MuConstant(Polynomial),
+		};
+
+		poly64x2_t Trunc32 = vsliq_n_u64(CRCVec0, Zero, 32);
+
+		const poly64x2_t MulHiLo = pmull_p64<1, 0>(Trunc32, Poly);
+
+		Trunc32                = vsliq_n_u64(MulHiLo, Zero, 32);
+		const poly64x2_t MulLo = pmull_p64<0, 0>(Trunc32, Poly);
+
+		CRCVec0 = veorq_u64(CRCVec0, MulLo);
+	}
+
+	return vgetq_lane_u32(CRCVec0, 1);
+}
+
+// Folds the remaining 16-byte blocks of Data into a 128-bit accumulator and
+// reduces it into a 32-bit CRC. A final partial block is handled by re-loading
+// the last 16 bytes of the input, so at least 16 bytes must precede Data.
+template<std::uint32_t Polynomial>
+inline std::uint32_t
+	CRC32_PMULL_Fold16(std::span<const std::byte> Data, poly64x2_t CRCVec0)
+{
+	const poly64x2_t K3K4 = poly64x2_t{
+		KnConstant(16 + 4, Polynomial),
+		KnConstant(16 - 4, Polynomial),
+	};
+
+	// Fold 128 bits at a time
+	for( ; Data.size() >= 16; Data = Data.subspan(16) )
+	{
+		const poly64x2_t Load
+			= vld1q_p64(reinterpret_cast<const poly64_t*>(Data.data()));
+
+		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec0, K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec0, K3K4);
+		CRCVec0                = eor3_p64(MulHi, MulLo, Load);
+	}
+
+	// The first n bytes of the accumulator are folded across the 16 bytes that
+	// follow them, which are the rest of the accumulator and the last n bytes
+	// of input
+	if( const std::ptrdiff_t Remainder = Data.size(); Remainder )
+	{
+		const uint8x16_t Last16 = vld1q_u8(
+			reinterpret_cast<const std::uint8_t*>(Data.data()) + Remainder
+			- 16);
+
+		const uint8x16_t ShiftRight = ByteShiftIndices(16 + Remainder);
+
+		const uint8x16_t Accumulator = vreinterpretq_u8_p64(CRCVec0);
+
+		const poly64x2_t Head = vreinterpretq_p64_u8(
+			vqtbl1q_u8(Accumulator, ByteShiftIndices(Remainder)));
+		const poly64x2_t Tail = vreinterpretq_p64_u8(vbslq_u8(
+			vcgeq_u8(ShiftRight, vdupq_n_u8(0x80)), Last16,
+			vqtbl1q_u8(Accumulator, ShiftRight)));
 
+		const poly64x2_t MulLo = pmull_p64<0, 0>(Head, K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(Head, K3K4);
+		CRCVec0                = eor3_p64(MulHi, MulLo, Tail);
+	}
+
+	return CRC32_PMULL_Barrett<Polynomial>(CRCVec0);
+}
+
+// Inputs shorter than a single block are zero-extended at the front, which
+// leaves their CRC unchanged, into one 16-byte block. The CRC is combined with
+// the first four bytes of input, and whatever part of it lies past the end of
+// an even shorter input is shifted across it.
+template<std::uint32_t Polynomial>
+inline std::uint32_t
+	CRC32_PMULL_Short(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	const std::size_t Length = Data.size();
+	if( Length == 0 )
+	{
+		return CRC;
+	}
+
+	alignas(16) std::array<std::uint8_t, 16> Block = {};
+	std::memcpy(Block.data() + 16 - Length, Data.data(), Length);
+
+	const std::uint32_t CRCLo
+		= Length >= 4 ? CRC : CRC & ((1u << (8 * Length)) - 1);
+	const std::uint32_t CRCHi = Length >= 4 ? 0u : CRC >> (8 * Length);
+
+	const poly64x2_t CRCVec0 = vreinterpretq_p64_u8(veorq_u8(
+		vld1q_u8(Block.data()),
+		vqtbl1q_u8(
+			vreinterpretq_u8_u32(vsetq_lane_u32(CRCLo, vdupq_n_u32(0), 0)),
+			ByteShiftIndices(Length))));
+
+	return CRC32_PMULL_Barrett<Polynomial>(CRCVec0) ^ CRCHi;
+}
+
+// Folds the 64-byte blocks of Data into the four accumulators of CRCVec,
+// returning the rest of Data that is too short to be folded
+template<std::uint32_t Polynomial>
+inline std::span<const std::byte>
+	CRC32_PMULL_Fold64(std::span<const std::byte> Data, poly64x2x4_t& CRCVec)
+{
 	// Fold 512 bits at a time
 	for( ; Data.size() >= 64; Data = Data.subspan(64) )
 	{
@@ -243,6 +373,15 @@ std::uint32_t CRC32_PMULL(std::span<const std::byte> Data, std::uint32_t CRC)
 		CRCVec.val[3] = eor3_p64(MulHi3, MulLo3, Load.val[3]);
 	}
 
+	return Data;
+}
+
+// Reduces the four accumulators of CRCVec into one, and then folds the rest of
+// Data into it as CRC32_PMULL_Fold16 does
+template<std::uint32_t Polynomial>
+inline std::uint32_t
+	CRC32_PMULL_Reduce(std::span<const std::byte> Data, poly64x2x4_t CRCVec)
+{
 	// Reduce 512 to 128
 	const poly64x2_t K3K4 = poly64x2_t{
 		KnConstant(16 + 4, Polynomial),
@@ -270,90 +409,64 @@ std::uint32_t CRC32_PMULL(std::span<const std::byte> Data, std::uint32_t CRC)
 		CRCVec.val[0]          = eor3_p64(MulHi, MulLo, CRCVec.val[3]);
 	}
 
-	// Fold 128 bits at a time
-	for( ; Data.size() >= 16; Data = Data.subspan(16) )
-	{
-		const poly64x2_t Load
-			= vld1q_p64(reinterpret_cast<const poly64_t*>(Data.data()));
-
-		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec.val[0], K3K4);
-		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec.val[0], K3K4);
-		CRCVec.val[0]          = eor3_p64(MulHi, MulLo, Load);
-	}
+	return CRC32_PMULL_Fold16<Polynomial>(Data, CRCVec.val[0]);
+}
 
-	// Reduce 128 to 64
-	const uint64x2_t Zero = vdupq_n_u64(0);
+template<std::uint32_t Polynomial>
+std::uint32_t CRC32_PMULL(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if( Data.size() < 16 )
 	{
-		const poly64x2_t MulHiLo = pmull_p64<1, 0>(CRCVec.val[0], K3K4);
-
-		const poly64x2_t Upper64 = vextq_s8(CRCVec.val[0], Zero, 8);
-
-		CRCVec.val[0] = veorq_u64(Upper64, MulHiLo);
-
-		const poly64x2_t K5K0 = poly64x2_t{
-			KnConstant(8, Polynomial),
-			0ull,
-		};
-
-		const poly64x2_t Upper96 = vextq_s8(CRCVec.val[0], Zero, 4);
-		const poly64x2_t Trunc32 = vsliq_n_u64(CRCVec.val[0], Zero, 32);
-
-		const poly64x2_t MulLo = pmull_p64<0, 0>(Trunc32, K5K0);
-
-		CRCVec.val[0] = veorq_u64(MulLo, Upper96);
+		return CRC32_PMULL_Short<Polynomial>(Data, CRC);
 	}
-
-	// Reduce 64 to 32
+	else if( Data.size() < 64 )
 	{
-		const poly64x2_t Poly = poly64x2_t{
-			KnConstant(4, Polynomial) | 1,
-			MuConstant(Polynomial),
-		};
+		const poly64x2_t CRCVec0 = veorq_u64(
+			vld1q_p64(reinterpret_cast<const poly64_t*>(Data.data())),
+			vsetq_lane_s32(CRC, vdupq_n_s32(0), 0));
+		return CRC32_PMULL_Fold16<Polynomial>(Data.subspan(16), CRCVec0);
+	}
 
-		poly64x2_t Trunc32 = vsliq_n_u64(CRCVec.val[0], Zero, 32);
+	poly64x2x4_t CRCVec
+		= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(Data.data()));
 
-		const poly64x2_t MulHiLo = pmull_p64<1, 0>(Trunc32, Poly);
+	Data = Data.subspan(64);
 
-		Trunc32                = vsliq_n_u64(MulHiLo, Zero, 32);
-		const poly64x2_t MulLo = pmull_p64<0, 0>(Trunc32, Poly);
+	CRCVec.val[0]
+		= veorq_u64(CRCVec.val[0], vsetq_lane_s32(CRC, vdupq_n_s32(0), 0));
 
-		CRCVec.val[0] = veorq_u64(CRCVec.val[0], MulLo);
-	}
+	Data = CRC32_PMULL_Fold64<Polynomial>(Data, CRCVec);
 
-	return vgetq_lane_u32(CRCVec.val[0], 1);
+	return CRC32_PMULL_Reduce<Polynomial>(Data, CRCVec);
 }
 #endif
 
-std::uint32_t Checksum(
-	std::span<const std::byte> Data, std::uint32_t InitialValue,
-	Polynomial Poly)
+// Each polynomial gets its own instantiation, with its tables, folding and
+// Barrett-reduction constants, and choice of kernel resolved at compile time
+template<Polynomial Poly>
+std::uint32_t
+	Checksum(std::span<const std::byte> Data, std::uint32_t InitialValue)
 {
-
-	const auto&   Table = GetCRC32Table(Poly);
+	const auto&   Table = CRC32TableStatic<Poly>()();
 	std::uint32_t CRC   = ~InitialValue;
 
 #if defined(__ARM_FEATURE_AES)
-	if( Poly == Polynomial::CRC32 )
+	// The `crc32` instructions are still used for short inputs of the
+	// polynomials that they implement
+#if defined(__ARM_FEATURE_CRC32)
+	constexpr bool HasCRC32Instructions
+		= Poly == Polynomial::CRC32 || Poly == Polynomial::CRC32C;
+#else
+	constexpr bool HasCRC32Instructions = false;
+#endif
+	if( Data.size() >= 64 || !HasCRC32Instructions )
 	{
-		if( Data.size() >= 64 )
-		{
-			if( Data.size() % 16 == 0 )
-			{
-				return ~CRC32_PMULL<BitReverse32(
-					std::uint32_t(Polynomial::CRC32))>(Data, CRC);
-			}
-			else
-			{
-				CRC = CRC32_PMULL<BitReverse32(
-					std::uint32_t(Polynomial::CRC32))>(Data, CRC);
-				return Checksum(Data.last(Data.size() % 16), ~CRC);
-			}
-		}
+		return ~CRC32_PMULL<BitReverse32(std::uint32_t(Poly))>(Data, CRC);
 	}
 #endif
 
 #if defined(__ARM_FEATURE_CRC32)
-	if( Poly == Polynomial::CRC32 )
+	if constexpr( Poly == Polynomial::CRC32 )
 	{
 		for( ; Data.size() / 8; )
 		{
@@ -388,7 +501,7 @@ std::uint32_t Checksum(
 			Data = Data.subspan(sizeof(std::uint8_t));
 		}
 	}
-	else if( Poly == Polynomial::CRC32C )
+	else if constexpr( Poly == Polynomial::CRC32C )
 	{
 		for( ; Data.size() / 8; )
 		{
@@ -489,12 +602,211 @@ std::uint32_t Checksum(
 
 	return ~std::accumulate(
 		Data.begin(), Data.end(), CRC,
-		[Table](std::uint32_t CurCRC, std::byte Byte) -> std::uint32_t {
+		[&Table](std::uint32_t CurCRC, std::byte Byte) -> std::uint32_t {
 			return (CurCRC >> 8)
 				 ^ Table[0][std::uint8_t(CurCRC) ^ std::uint8_t(Byte)];
 		});
 }
 
+template std::uint32_t Checksum<Polynomial::CRC32>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32C>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32K>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32K2>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32Q>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+
+std::uint32_t Checksum(
+	std::span<const std::byte> Data, std::uint32_t InitialValue,
+	Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return Checksum<Polynomial::CRC32>(Data, InitialValue);
+	case Polynomial::CRC32C:
+		return Checksum<Polynomial::CRC32C>(Data, InitialValue);
+	case Polynomial::CRC32K:
+		return Checksum<Polynomial::CRC32K>(Data, InitialValue);
+	case Polynomial::CRC32K2:
+		return Checksum<Polynomial::CRC32K2>(Data, InitialValue);
+	case Polynomial::CRC32Q:
+		return Checksum<Polynomial::CRC32Q>(Data, InitialValue);
+	}
+}
+
+// Each polynomial has the one kernel, resolved at compile time, so there is
+// nothing for a profile to choose between
+static std::uint32_t Checksum_Default(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	return ~Checksum(Data, ~CRC, Poly);
+}
+
+std::span<const ChecksumKernel> GetChecksumKernels()
+{
+	static constexpr ChecksumKernel Kernels[] = {
+		{"Default", Checksum_Default},
+	};
+	return Kernels;
+}
+
+std::string GetHostIdentity()
+{
+	// There is only ever the one kernel to choose, whatever the processor
+	return "aarch64";
+}
+
+// Out-of-order cores already overlap the independent fold chains of
+// consecutive inputs
+void Checksum(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t> Checksums, Polynomial Poly)
+{
+	for( std::size_t i = 0; i < Inputs.size(); ++i )
+	{
+		Checksums[i] = Checksum(Inputs[i], 0, Poly);
+	}
+}
+
+#if defined(__ARM_FEATURE_AES)
+using CRC32FoldKernelT = std::span<const std::byte> (*)(
+	std::span<const std::byte> Data, poly64x2x4_t& CRCVec);
+
+using CRC32ReduceKernelT = std::uint32_t (*)(
+	std::span<const std::byte> Data, poly64x2x4_t CRCVec);
+
+static CRC32FoldKernelT GetCRC32_PMULL_Fold(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PMULL_Fold64<BitReverse32(
+			std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PMULL_Fold64<BitReverse32(
+			std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PMULL_Fold64<BitReverse32(
+			std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PMULL_Fold64<BitReverse32(
+			std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PMULL_Fold64<BitReverse32(
+			std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32ReduceKernelT GetCRC32_PMULL_Reduce(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PMULL_Reduce<BitReverse32(
+			std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PMULL_Reduce<BitReverse32(
+			std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PMULL_Reduce<BitReverse32(
+			std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PMULL_Reduce<BitReverse32(
+			std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PMULL_Reduce<BitReverse32(
+			std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+// Folds Data into the 512-bit State of a Hasher
+static std::span<const std::byte> HasherFoldBlocks(
+	CRC32FoldKernelT Fold, std::span<const std::byte> Data,
+	std::span<std::byte, 64> State)
+{
+	poly64x2x4_t CRCVec
+		= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(State.data()));
+
+	Data = Fold(Data, CRCVec);
+
+	vst1q_p64_x4(reinterpret_cast<poly64_t*>(State.data()), CRCVec);
+
+	return Data;
+}
+#endif
+
+// Every polynomial is folded with PMULL, which is also what Checksum uses for
+// the largest inputs. Without it, the hasher only carries the CRC register
+// between updates.
+Hasher::Hasher(Polynomial HasherPoly, std::uint32_t InitialValue)
+	: Poly(HasherPoly), CRC(~InitialValue)
+{
+#if defined(__ARM_FEATURE_AES)
+	// The fold state starts out as a 64-byte block that ends with the initial
+	// CRC, shifted back across itself
+	const std::uint32_t Prefix = UnshiftCRC32(CRC, Poly);
+
+	FoldState.fill(std::byte{0});
+	std::memcpy(
+		FoldState.data() + FoldState.size() - sizeof(Prefix), &Prefix,
+		sizeof(Prefix));
+#endif
+}
+
+void Hasher::Update(std::span<const std::byte> Data)
+{
+#if defined(__ARM_FEATURE_AES)
+	const CRC32FoldKernelT Fold = GetCRC32_PMULL_Fold(Poly);
+
+	// Complete the block left over from the previous update first
+	if( CarrySize )
+	{
+		const std::size_t Count = std::min(64 - CarrySize, Data.size());
+		std::memcpy(Carry.data() + 16 + CarrySize, Data.data(), Count);
+		CarrySize += Count;
+		Data = Data.subspan(Count);
+
+		if( CarrySize < 64 )
+		{
+			return;
+		}
+
+		HasherFoldBlocks(Fold, std::span(Carry).subspan(16), FoldState);
+		CarrySize = 0;
+	}
+
+	if( Data.size() >= 64 )
+	{
+		Data = HasherFoldBlocks(Fold, Data, FoldState);
+	}
+
+	std::memcpy(Carry.data() + 16, Data.data(), Data.size());
+	CarrySize = Data.size();
+#else
+	CRC = ~Checksum(Data, ~CRC, Poly);
+#endif
+}
+
+std::uint32_t Hasher::Finalize() const
+{
+#if defined(__ARM_FEATURE_AES)
+	const poly64x2x4_t CRCVec
+		= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(FoldState.data()));
+
+	return ~GetCRC32_PMULL_Reduce(Poly)(
+		std::span(Carry).subspan(16, CarrySize), CRCVec);
+#else
+	return ~CRC;
+#endif
+}
+
 } // namespace CRC
 
 #endif
\ No newline at end of file
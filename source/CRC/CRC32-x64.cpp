@@ -2,6 +2,16 @@
 
 #include <CRC32.hpp>
 
+#include "CRC32-Kernels.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <cpuid.h>
+
 namespace CRC
 {
 
@@ -150,93 +160,137 @@ static_assert(KnConstant(      4, IEEEPOLY) == 0x1DB710640);
 static_assert(MuConstant(         IEEEPOLY) == 0x1F7011641);
 // clang-format on
 
-#ifdef __PCLMUL__
+// Kernels are compiled for the instruction-set extensions that they need and
+// are selected at runtime based on the features of the host processor
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw,avx512dq")))
+#define TARGET_PCLMULQDQ __attribute__((target("sse4.2,pclmul")))
+#define TARGET_VPCLMULQDQ_256                                                  \
+	__attribute__((target("sse4.2,pclmul,avx2,vpclmulqdq")))
+#define TARGET_VPCLMULQDQ                                                      \
+	__attribute__((target(                                                     \
+		"sse4.2,pclmul,avx2,avx512f,avx512bw,avx512dq,avx512vl,vpclmulqdq")))
+
+// Sliding window of `pshufb` indices. Sixteen indices loaded from an offset of
+// (16 - n) shift a vector left by n bytes, and from an offset of (16 + n) shift
+// it right by n bytes, with the vacated bytes set to zero.
+alignas(16) static constexpr std::array<std::uint8_t, 48> ByteShiftTable = {
+	// clang-format off
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	// clang-format on
+};
+
+TARGET_PCLMULQDQ inline __m128i ByteShiftIndices(std::ptrdiff_t Offset)
+{
+	return _mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(ByteShiftTable.data() + Offset));
+}
+
+// Reduces a 128-bit fold accumulator into a 32-bit CRC
 template<std::uint32_t Polynomial>
-std::uint32_t
-	CRC32_PCLMULQDQ(std::span<const std::byte> Data, std::uint32_t CRC)
+TARGET_PCLMULQDQ inline std::uint32_t CRC32_PCLMULQDQ_Barrett(__m128i CRCVec0)
 {
+	const __m128i K3K4 = _mm_set_epi64x(
+		KnConstant(16 - 4, Polynomial), KnConstant(16 + 4, Polynomial));
 
-	__m128i CRCVec0
-		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
-	__m128i CRCVec1
-		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
-	__m128i CRCVec2
-		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
-	__m128i CRCVec3
-		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+	// Reduce 128 to 64
+	const __m128i Lo32Mask64 = _mm_set1_epi64x(0xFFFFFFFF);
+	{
+		const __m128i MulHiLo
+			= _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0000);
 
-	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi32_si128(CRC));
+		const __m128i Upper64 = _mm_srli_si128(CRCVec0, 8);
+
+		CRCVec0 = _mm_xor_si128(Upper64, MulHiLo);
 
-	Data = Data.subspan(64);
+		const __m128i K5K0 = _mm_cvtsi64_si128(KnConstant(8, Polynomial));
 
-	// Fold 512 bits at a time
-#if defined(__AVX512F__) && defined(__AVX512VL__) && defined(__VPCLMULQDQ__)
+		const __m128i Upper96 = _mm_srli_si128(CRCVec0, 4);
+
+		const __m128i Trunc32 = _mm_and_si128(CRCVec0, Lo32Mask64);
+
+		const __m128i MulLo = _mm_clmulepi64_si128(Trunc32, K5K0, 0b0000'0000);
+
+		CRCVec0 = _mm_xor_si128(MulLo, Upper96);
+	}
+
+	// Reduce 64 to 32
 	{
-		__m512i CRCVec_512 = _mm512_undefined();
+		const __m128i Poly = _mm_set_epi64x(
+			MuConstant(Polynomial), KnConstant(4, Polynomial) | 1);
 
-		CRCVec_512 = _mm512_inserti32x4(CRCVec_512, CRCVec0, 0);
-		CRCVec_512 = _mm512_inserti32x4(CRCVec_512, CRCVec1, 1);
-		CRCVec_512 = _mm512_inserti32x4(CRCVec_512, CRCVec2, 2);
-		CRCVec_512 = _mm512_inserti32x4(CRCVec_512, CRCVec3, 3);
+		__m128i Trunc32 = _mm_and_si128(CRCVec0, Lo32Mask64);
 
-		const __m512i K1K2 = _mm512_set_epi64(
-			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
-			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
-			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
-			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+		const __m128i MulHiLo
+			= _mm_clmulepi64_si128(Trunc32, Poly, 0b0001'0000);
 
-		for( ; Data.size() >= 64; Data = Data.subspan(64) )
-		{
+		Trunc32             = _mm_and_si128(MulHiLo, Lo32Mask64);
+		const __m128i MulLo = _mm_clmulepi64_si128(Trunc32, Poly, 0b0000'0000);
 
-			const __m512i MulLo
-				= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0000'0000);
+		CRCVec0 = _mm_xor_si128(CRCVec0, MulLo);
+	}
 
-			const __m512i MulHi
-				= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0001'0001);
+	return _mm_extract_epi32(CRCVec0, 1);
+}
 
-			const __m512i Load = _mm512_loadu_si512(
-				&reinterpret_cast<const __m512i*>(Data.data())[0]);
+// Folds the remaining 16-byte blocks of Data into a 128-bit accumulator and
+// reduces it into a 32-bit CRC. A final partial block is handled by re-loading
+// the last 16 bytes of the input, so at least 16 bytes must precede Data.
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint32_t
+	CRC32_PCLMULQDQ_Fold16(std::span<const std::byte> Data, __m128i CRCVec0)
+{
+	const __m128i K3K4 = _mm_set_epi64x(
+		KnConstant(16 - 4, Polynomial), KnConstant(16 + 4, Polynomial));
 
-			CRCVec_512 = _mm512_xor_si512(_mm512_xor_si512(MulHi, MulLo), Load);
-		}
+	// Fold 128 bits at a time
+	for( ; Data.size() >= 16; Data = Data.subspan(16) )
+	{
+		const __m128i Load
+			= _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data.data()));
+
+		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
 
-		CRCVec0 = _mm512_extracti32x4_epi32(CRCVec_512, 0);
-		CRCVec1 = _mm512_extracti32x4_epi32(CRCVec_512, 1);
-		CRCVec2 = _mm512_extracti32x4_epi32(CRCVec_512, 2);
-		CRCVec3 = _mm512_extracti32x4_epi32(CRCVec_512, 3);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Load);
 	}
-#else
-	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+
+	// The first n bytes of the accumulator are folded across the 16 bytes that
+	// follow them, which are the rest of the accumulator and the last n bytes
+	// of input
+	if( const std::ptrdiff_t Remainder = Data.size(); Remainder )
 	{
-		const __m128i K1K2 = _mm_set_epi64x(
-			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+		const __m128i Last16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+			Data.data() + Remainder - 16));
 
-		const __m128i MulLo0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0000'0000);
-		const __m128i MulLo1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0000'0000);
-		const __m128i MulLo2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0000'0000);
-		const __m128i MulLo3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0000'0000);
+		const __m128i ShiftRight = ByteShiftIndices(16 + Remainder);
 
-		const __m128i MulHi0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0001'0001);
-		const __m128i MulHi1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0001'0001);
-		const __m128i MulHi2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0001'0001);
-		const __m128i MulHi3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0001'0001);
+		const __m128i Head
+			= _mm_shuffle_epi8(CRCVec0, ByteShiftIndices(Remainder));
+		const __m128i Tail = _mm_blendv_epi8(
+			_mm_shuffle_epi8(CRCVec0, ShiftRight), Last16, ShiftRight);
 
-		const __m128i Load0 = _mm_loadu_si128(
-			&reinterpret_cast<const __m128i*>(Data.data())[0]);
-		const __m128i Load1 = _mm_loadu_si128(
-			&reinterpret_cast<const __m128i*>(Data.data())[1]);
-		const __m128i Load2 = _mm_loadu_si128(
-			&reinterpret_cast<const __m128i*>(Data.data())[2]);
-		const __m128i Load3 = _mm_loadu_si128(
-			&reinterpret_cast<const __m128i*>(Data.data())[3]);
+		const __m128i MulLo = _mm_clmulepi64_si128(Head, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(Head, K3K4, 0b0001'0001);
 
-		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi0, MulLo0), Load0);
-		CRCVec1 = _mm_xor_si128(_mm_xor_si128(MulHi1, MulLo1), Load1);
-		CRCVec2 = _mm_xor_si128(_mm_xor_si128(MulHi2, MulLo2), Load2);
-		CRCVec3 = _mm_xor_si128(_mm_xor_si128(MulHi3, MulLo3), Load3);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Tail);
 	}
-#endif
 
+	return CRC32_PCLMULQDQ_Barrett<Polynomial>(CRCVec0);
+}
+
+// Reduces four 128-bit fold accumulators into a 32-bit CRC, folding in the
+// rest of Data along the way
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint32_t CRC32_PCLMULQDQ_Reduce(
+	std::span<const std::byte> Data, __m128i CRCVec0, __m128i CRCVec1,
+	__m128i CRCVec2, __m128i CRCVec3)
+{
 	// Reduce 512 to 128
 	const __m128i K3K4 = _mm_set_epi64x(
 		KnConstant(16 - 4, Polynomial), KnConstant(16 + 4, Polynomial));
@@ -262,250 +316,1600 @@ std::uint32_t
 		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), CRCVec3);
 	}
 
-	// Fold 128 bits at a time
-	for( ; Data.size() >= 16; Data = Data.subspan(16) )
+	return CRC32_PCLMULQDQ_Fold16<Polynomial>(Data, CRCVec0);
+}
+
+// `pshufb` indices that move the bytes gathered by CRC32_PCLMULQDQ_Short into
+// the end of a 16-byte block, for each input length
+consteval std::array<std::array<std::uint8_t, 16>, 16> ShortGatherTable()
+{
+	std::array<std::array<std::uint8_t, 16>, 16> Table = {};
+	for( std::size_t Length = 0; Length < 16; ++Length )
 	{
-		const __m128i Load
-			= _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data.data()));
+		for( std::size_t i = 0; i < 16; ++i )
+		{
+			if( i < 16 - Length )
+			{
+				Table[Length][i] = 0x80;
+				continue;
+			}
 
-		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
-		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
+			const std::size_t ByteIndex = i - (16 - Length);
+			if( Length >= 8 )
+			{
+				Table[Length][i]
+					= ByteIndex < 8 ? ByteIndex : ByteIndex + 16 - Length;
+			}
+			else if( Length >= 4 )
+			{
+				Table[Length][i]
+					= ByteIndex < 4 ? ByteIndex : ByteIndex + 8 - Length;
+			}
+			else
+			{
+				Table[Length][i] = ByteIndex;
+			}
+		}
+	}
+	return Table;
+}
 
-		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Load);
+alignas(16) static constexpr std::array<std::array<std::uint8_t, 16>, 16>
+	ShortGather = ShortGatherTable();
+
+// Inputs shorter than a single block are zero-extended at the front, which
+// leaves their CRC unchanged, into one 16-byte block. The CRC is combined with
+// the first four bytes of input, and whatever part of it lies past the end of
+// an even shorter input is shifted across it.
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint32_t
+	CRC32_PCLMULQDQ_Short(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	const std::size_t Length = Data.size();
+	if( Length == 0 )
+	{
+		return CRC;
 	}
 
-	// Reduce 128 to 64
-	const __m128i Lo32Mask64 = _mm_set1_epi64x(0xFFFFFFFF);
+	const std::uint32_t CRCLo
+		= Length >= 4 ? CRC : CRC & ((1u << (8 * Length)) - 1);
+	const std::uint32_t CRCHi = Length >= 4 ? 0u : CRC >> (8 * Length);
+
+	// Gather the input with a pair of overlapping loads, without reading past
+	// either end of it
+	const auto*   Bytes = reinterpret_cast<const std::uint8_t*>(Data.data());
+	std::uint64_t Lo = 0, Hi = 0;
+	if( Length >= 8 )
 	{
-		const __m128i MulHiLo
-			= _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0000);
+		Lo = *reinterpret_cast<const std::uint64_t*>(Bytes);
+		Hi = *reinterpret_cast<const std::uint64_t*>(Bytes + Length - 8);
+	}
+	else if( Length >= 4 )
+	{
+		Lo = *reinterpret_cast<const std::uint32_t*>(Bytes)
+		   | std::uint64_t(
+				 *reinterpret_cast<const std::uint32_t*>(Bytes + Length - 4))
+				 << 32;
+	}
+	else
+	{
+		Lo = Bytes[0] | (Bytes[Length / 2] << 8) | (Bytes[Length - 1] << 16);
+	}
 
-		const __m128i Upper64 = _mm_srli_si128(CRCVec0, 8);
+	const __m128i CRCVec0 = _mm_shuffle_epi8(
+		_mm_set_epi64x(Hi, Lo ^ CRCLo),
+		_mm_load_si128(
+			reinterpret_cast<const __m128i*>(ShortGather[Length].data())));
 
-		CRCVec0 = _mm_xor_si128(Upper64, MulHiLo);
+	return CRC32_PCLMULQDQ_Barrett<Polynomial>(CRCVec0) ^ CRCHi;
+}
 
-		const __m128i K5K0 = _mm_cvtsi64_si128(KnConstant(8, Polynomial));
+// Folds every whole 64-byte block of Data into four 128-bit accumulators,
+// returning whatever is left over
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ std::span<const std::byte> CRC32_PCLMULQDQ_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0, __m128i& CRCVec1,
+	__m128i& CRCVec2, __m128i& CRCVec3)
+{
+	// Fold 512 bits at a time
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m128i K1K2 = _mm_set_epi64x(
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
 
-		const __m128i Upper96 = _mm_srli_si128(CRCVec0, 4);
+		const __m128i MulLo0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0000'0000);
+		const __m128i MulLo1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0000'0000);
+		const __m128i MulLo2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0000'0000);
+		const __m128i MulLo3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0000'0000);
 
-		const __m128i Trunc32 = _mm_and_si128(CRCVec0, Lo32Mask64);
+		const __m128i MulHi0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0001'0001);
+		const __m128i MulHi1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0001'0001);
+		const __m128i MulHi2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0001'0001);
+		const __m128i MulHi3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0001'0001);
 
-		const __m128i MulLo = _mm_clmulepi64_si128(Trunc32, K5K0, 0b0000'0000);
+		const __m128i Load0 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[0]);
+		const __m128i Load1 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[1]);
+		const __m128i Load2 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[2]);
+		const __m128i Load3 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[3]);
 
-		CRCVec0 = _mm_xor_si128(MulLo, Upper96);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi0, MulLo0), Load0);
+		CRCVec1 = _mm_xor_si128(_mm_xor_si128(MulHi1, MulLo1), Load1);
+		CRCVec2 = _mm_xor_si128(_mm_xor_si128(MulHi2, MulLo2), Load2);
+		CRCVec3 = _mm_xor_si128(_mm_xor_si128(MulHi3, MulLo3), Load3);
 	}
 
-	// Reduce 64 to 32
+	return Data;
+}
+
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ std::uint32_t
+	CRC32_PCLMULQDQ(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if( Data.size() < 16 )
 	{
-		const __m128i Poly = _mm_set_epi64x(
-			MuConstant(Polynomial), KnConstant(4, Polynomial) | 1);
+		return CRC32_PCLMULQDQ_Short<Polynomial>(Data, CRC);
+	}
+	else if( Data.size() < 64 )
+	{
+		const __m128i CRCVec0 = _mm_xor_si128(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data.data())),
+			_mm_cvtsi32_si128(CRC));
+		return CRC32_PCLMULQDQ_Fold16<Polynomial>(Data.subspan(16), CRCVec0);
+	}
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
 
-		__m128i Trunc32 = _mm_and_si128(CRCVec0, Lo32Mask64);
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi32_si128(CRC));
 
-		const __m128i MulHiLo
-			= _mm_clmulepi64_si128(Trunc32, Poly, 0b0001'0000);
+	Data = CRC32_PCLMULQDQ_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
 
-		Trunc32             = _mm_and_si128(MulHiLo, Lo32Mask64);
-		const __m128i MulLo = _mm_clmulepi64_si128(Trunc32, Poly, 0b0000'0000);
+	return CRC32_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
 
-		CRCVec0 = _mm_xor_si128(CRCVec0, MulLo);
-	}
+// Number of independent inputs whose fold chains are interleaved together
+static constexpr std::size_t BatchLanes = 8;
 
-	return _mm_extract_epi32(CRCVec0, 1);
-}
-#endif
+// Inputs at least this large keep the single-input kernels busy enough on their
+// own, and are not interleaved with others
+static constexpr std::size_t BatchInputSize = 128;
 
-#ifdef __AVX2__
-inline std::uint32_t _mm256_hxor_epi32(__m256i a)
+// Folds the next Length bytes of each lane, 128 bits at a time and in
+// lock-step. The lane count is fixed so that the accumulators stay within
+// registers.
+template<std::uint32_t Polynomial, std::size_t LaneCount>
+TARGET_PCLMULQDQ inline void CRC32_PCLMULQDQ_FoldLanes(
+	const std::byte* const* Lanes, __m128i* CRCVec, std::size_t Length)
 {
-	// Xor top half with bottom half
-	const __m128i XorReduce128 = _mm_xor_si128(
-		_mm256_extracti128_si256(a, 1), _mm256_castsi256_si128(a));
-	const std::uint64_t XorReduce64 = _mm_extract_epi64(XorReduce128, 1)
-									^ _mm_extract_epi64(XorReduce128, 0);
-	return XorReduce64 ^ (XorReduce64 >> 32);
+	const __m128i K3K4 = _mm_set_epi64x(
+		KnConstant(16 - 4, Polynomial), KnConstant(16 + 4, Polynomial));
+
+	__m128i Vec[LaneCount];
+	for( std::size_t i = 0; i < LaneCount; ++i )
+	{
+		Vec[i] = CRCVec[i];
+	}
+
+	for( std::size_t Offset = 0; Offset < Length; Offset += 16 )
+	{
+#pragma GCC unroll 8
+		for( std::size_t i = 0; i < LaneCount; ++i )
+		{
+			const __m128i Load = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(Lanes[i] + Offset));
+
+			const __m128i MulLo
+				= _mm_clmulepi64_si128(Vec[i], K3K4, 0b0000'0000);
+			const __m128i MulHi
+				= _mm_clmulepi64_si128(Vec[i], K3K4, 0b0001'0001);
+
+			Vec[i] = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Load);
+		}
+	}
+
+	for( std::size_t i = 0; i < LaneCount; ++i )
+	{
+		CRCVec[i] = Vec[i];
+	}
 }
-#endif
 
-std::uint32_t Checksum(
-	std::span<const std::byte> Data, std::uint32_t InitialValue,
-	Polynomial Poly)
+// Folds up to BatchLanes independent inputs in lock-step, so that the latency
+// of each of their carry-less multiplies is hidden behind the others. Inputs of
+// BatchInputSize bytes or more are skipped.
+template<std::uint32_t Polynomial>
+TARGET_PCLMULQDQ void CRC32_PCLMULQDQ_Batch(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t>                    CRCs)
 {
+	// Each lane has folded its input up to Lanes[i], and ends at LaneEnds[i]
+	std::array<const std::byte*, BatchLanes> Lanes;
+	std::array<const std::byte*, BatchLanes> LaneEnds;
+	std::array<std::size_t, BatchLanes>      LaneInputs;
+	__m128i                                  CRCVec[BatchLanes];
+	std::size_t                              LaneCount = 0;
+
+	for( std::size_t i = 0; i < Inputs.size(); ++i )
+	{
+		if( Inputs[i].size() >= BatchInputSize )
+		{
+			continue;
+		}
+		else if( Inputs[i].size() < 16 )
+		{
+			CRCs[i] = CRC32_PCLMULQDQ_Short<Polynomial>(Inputs[i], CRCs[i]);
+			continue;
+		}
 
-	const auto&   Table = GetCRC32Table(Poly);
-	std::uint32_t CRC   = ~InitialValue;
+		CRCVec[LaneCount] = _mm_xor_si128(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Inputs[i].data())),
+			_mm_cvtsi32_si128(CRCs[i]));
+		Lanes[LaneCount]      = Inputs[i].data() + 16;
+		LaneEnds[LaneCount]   = Inputs[i].data() + Inputs[i].size();
+		LaneInputs[LaneCount] = i;
+		++LaneCount;
+	}
 
-#if defined(__PCLMUL__)
-	if( Poly == Polynomial::CRC32 )
+	while( true )
 	{
-		if( Data.size() >= 64 )
+		// Lanes without any full blocks left are reduced and retired, and the
+		// last lane is moved into their place
+		for( std::size_t i = 0; i < LaneCount; )
 		{
-			if( Data.size() % 16 == 0 )
+			if( LaneEnds[i] - Lanes[i] >= 16 )
 			{
-				return ~CRC32_PCLMULQDQ<BitReverse32(
-					std::uint32_t(Polynomial::CRC32))>(Data, CRC);
-			}
-			else
-			{
-				CRC = CRC32_PCLMULQDQ<BitReverse32(
-					std::uint32_t(Polynomial::CRC32))>(Data, CRC);
-				return Checksum(Data.last(Data.size() % 16), ~CRC);
+				++i;
+				continue;
 			}
+
+			CRCs[LaneInputs[i]] = CRC32_PCLMULQDQ_Fold16<Polynomial>(
+				std::span(Lanes[i], LaneEnds[i]), CRCVec[i]);
+
+			--LaneCount;
+			Lanes[i]      = Lanes[LaneCount];
+			LaneEnds[i]   = LaneEnds[LaneCount];
+			LaneInputs[i] = LaneInputs[LaneCount];
+			CRCVec[i]     = CRCVec[LaneCount];
 		}
-	}
-#endif
 
-	// Slice by 16
-	{
-#if defined(__AVX512F__) && defined(__AVX512BW__)
-		const __m512i ByteIndex = _mm512_set_epi8(
-			~0, ~0, ~0, 15, ~0, ~0, ~0, 14, ~0, ~0, ~0, 13, ~0, ~0, ~0, 12, ~0,
-			~0, ~0, 11, ~0, ~0, ~0, 10, ~0, ~0, ~0, 9, ~0, ~0, ~0, 8, ~0, ~0,
-			~0, 7, ~0, ~0, ~0, 6, ~0, ~0, ~0, 5, ~0, ~0, ~0, 4, ~0, ~0, ~0, 3,
-			~0, ~0, ~0, 2, ~0, ~0, ~0, 1, ~0, ~0, ~0, 0);
-		// Offset into the multi-dimensional array
-		const __m512i ArrayOffset = _mm512_set_epi32(
-			(sizeof(CRC32TableT::value_type) / 4) * 0,
-			(sizeof(CRC32TableT::value_type) / 4) * 1,
-			(sizeof(CRC32TableT::value_type) / 4) * 2,
-			(sizeof(CRC32TableT::value_type) / 4) * 3,
-			(sizeof(CRC32TableT::value_type) / 4) * 4,
-			(sizeof(CRC32TableT::value_type) / 4) * 5,
-			(sizeof(CRC32TableT::value_type) / 4) * 6,
-			(sizeof(CRC32TableT::value_type) / 4) * 7,
-			(sizeof(CRC32TableT::value_type) / 4) * 8,
-			(sizeof(CRC32TableT::value_type) / 4) * 9,
-			(sizeof(CRC32TableT::value_type) / 4) * 10,
-			(sizeof(CRC32TableT::value_type) / 4) * 11,
-			(sizeof(CRC32TableT::value_type) / 4) * 12,
-			(sizeof(CRC32TableT::value_type) / 4) * 13,
-			(sizeof(CRC32TableT::value_type) / 4) * 14,
-			(sizeof(CRC32TableT::value_type) / 4) * 15);
-		for( ; Data.size() / 16; )
+		if( LaneCount == 0 )
 		{
-			// Load in 8 bytes
-			const std::uint64_t Input64Lo
-				= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
-			Data = Data.subspan(sizeof(std::uint64_t));
-			const std::uint64_t Input64Hi
-				= *reinterpret_cast<const std::uint64_t*>(Data.data());
-			Data = Data.subspan(sizeof(std::uint64_t));
-			// Spread out each byte into a eight 32-bit lanes, in each 256-bit
-			// lane
-			const __m512i Indices = _mm512_shuffle_epi8(
-				_mm512_unpacklo_epi64(
-					_mm512_set1_epi64(Input64Lo), _mm512_set1_epi64(Input64Hi)),
-				ByteIndex);
-			// Use the spread out bytes to gather
-			const __m512i Gather = _mm512_i32gather_epi32(
-				_mm512_add_epi32(Indices, ArrayOffset),
-				reinterpret_cast<const std::int32_t*>(Table.data()),
-				sizeof(std::uint32_t));
-			CRC = _mm256_hxor_epi32(_mm256_xor_si256(
-				_mm512_castsi512_si256(Gather),
-				_mm512_extracti32x8_epi32(Gather, 1)));
+			return;
 		}
-#else
-		for( ; Data.size() / 16; )
+
+		// Fold each lane for as long as the shortest of them has full blocks
+		std::size_t Length = LaneEnds[0] - Lanes[0];
+		for( std::size_t i = 1; i < LaneCount; ++i )
 		{
-			const std::uint32_t InputLoLo
-				= *reinterpret_cast<const std::uint32_t*>(Data.data()) ^ CRC;
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			const std::uint32_t InputHiLo
-				= *reinterpret_cast<const std::uint32_t*>(Data.data());
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			const std::uint32_t InputLoHi
-				= *reinterpret_cast<const std::uint32_t*>(Data.data());
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			const std::uint32_t InputHiHi
-				= *reinterpret_cast<const std::uint32_t*>(Data.data());
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			CRC = Table[15][std::uint8_t(InputLoLo)]
-				^ Table[14][std::uint8_t(InputLoLo >> 8)]
-				^ Table[13][std::uint8_t(InputLoLo >> 16)]
-				^ Table[12][std::uint8_t(InputLoLo >> 24)]
-				^ Table[11][std::uint8_t(InputHiLo)]
-				^ Table[10][std::uint8_t(InputHiLo >> 8)]
-				^ Table[9][std::uint8_t(InputHiLo >> 16)]
-				^ Table[8][std::uint8_t(InputHiLo >> 24)]
-				^ Table[7][std::uint8_t(InputLoHi)]
-				^ Table[6][std::uint8_t(InputLoHi >> 8)]
-				^ Table[5][std::uint8_t(InputLoHi >> 16)]
-				^ Table[4][std::uint8_t(InputLoHi >> 24)]
-				^ Table[3][std::uint8_t(InputHiHi)]
-				^ Table[2][std::uint8_t(InputHiHi >> 8)]
-				^ Table[1][std::uint8_t(InputHiHi >> 16)]
-				^ Table[0][std::uint8_t(InputHiHi >> 24)];
+			Length = std::min<std::size_t>(Length, LaneEnds[i] - Lanes[i]);
 		}
-#endif
-	}
+		Length &= ~std::size_t(15);
 
-	// Slice by 8
-	{
-#if defined(__AVX2__)
-		const __m256i ByteIndex = _mm256_set_epi8(
-			~0, ~0, ~0, 7, ~0, ~0, ~0, 6, ~0, ~0, ~0, 5, ~0, ~0, ~0, 4, ~0, ~0,
-			~0, 3, ~0, ~0, ~0, 2, ~0, ~0, ~0, 1, ~0, ~0, ~0, 0);
-		// Offset into the multi-dimensional array
-		const __m256i ArrayOffset = _mm256_set_epi32(
-			(sizeof(CRC32TableT::value_type) / 4) * 0,
-			(sizeof(CRC32TableT::value_type) / 4) * 1,
-			(sizeof(CRC32TableT::value_type) / 4) * 2,
-			(sizeof(CRC32TableT::value_type) / 4) * 3,
-			(sizeof(CRC32TableT::value_type) / 4) * 4,
-			(sizeof(CRC32TableT::value_type) / 4) * 5,
-			(sizeof(CRC32TableT::value_type) / 4) * 6,
-			(sizeof(CRC32TableT::value_type) / 4) * 7);
-		for( ; Data.size() / 8; Data.subspan(8) )
+		switch( LaneCount )
 		{
-			// Load in 8 bytes
-			const std::uint64_t Input64
-				= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
-			Data = Data.subspan(sizeof(std::uint64_t));
-			// Spread out each byte into a eight 32-bit lanes
-			const __m256i Indices
-				= _mm256_shuffle_epi8(_mm256_set1_epi64x(Input64), ByteIndex);
-			// Use the spread out bytes to gather
-			const __m256i Gather = _mm256_i32gather_epi32(
-				reinterpret_cast<const std::int32_t*>(Table.data()),
-				_mm256_add_epi32(Indices, ArrayOffset), sizeof(std::uint32_t));
-			CRC = _mm256_hxor_epi32(Gather);
+		case 1:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 1>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 2:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 2>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 3:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 3>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 4:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 4>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 5:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 5>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 6:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 6>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 7:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 7>(
+				Lanes.data(), CRCVec, Length);
+			break;
+		case 8:
+			CRC32_PCLMULQDQ_FoldLanes<Polynomial, 8>(
+				Lanes.data(), CRCVec, Length);
+			break;
 		}
-#else
-		for( ; Data.size() / 8; )
+
+		for( std::size_t i = 0; i < LaneCount; ++i )
 		{
-			const std::uint32_t InputLo
-				= *reinterpret_cast<const std::uint32_t*>(Data.data()) ^ CRC;
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			const std::uint32_t InputHi
-				= *reinterpret_cast<const std::uint32_t*>(Data.data());
-			Data = Data.subspan(sizeof(std::uint32_t));
-
-			CRC = Table[7][std::uint8_t(InputLo)]
-				^ Table[6][std::uint8_t(InputLo >> 8)]
-				^ Table[5][std::uint8_t(InputLo >> 16)]
-				^ Table[4][std::uint8_t(InputLo >> 24)]
-				^ Table[3][std::uint8_t(InputHi)]
-				^ Table[2][std::uint8_t(InputHi >> 8)]
-				^ Table[1][std::uint8_t(InputHi >> 16)]
-				^ Table[0][std::uint8_t(InputHi >> 24)];
+			Lanes[i] += Length;
 		}
-#endif
 	}
-
-	return ~std::accumulate(
-		Data.begin(), Data.end(), CRC,
-		[Table](std::uint32_t CurCRC, std::byte Byte) -> std::uint32_t {
-			return (CurCRC >> 8)
-				 ^ Table[0][std::uint8_t(CurCRC) ^ std::uint8_t(Byte)];
-		});
 }
 
-} // namespace CRC
+// For processors with 256-bit carry-less multiplies but without AVX-512
+template<std::uint32_t Polynomial>
+TARGET_VPCLMULQDQ_256 std::span<const std::byte> CRC32_VPCLMULQDQ_256_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0_128, __m128i& CRCVec1_128,
+	__m128i& CRCVec2_128, __m128i& CRCVec3_128)
+{
+	__m256i CRCVec0 = _mm256_set_m128i(CRCVec1_128, CRCVec0_128);
+	__m256i CRCVec1 = _mm256_set_m128i(CRCVec3_128, CRCVec2_128);
 
-#endif
\ No newline at end of file
+	// Fold 1024 bits at a time, with four independent accumulators
+	if( Data.size() >= 64 )
+	{
+		const __m256i K1K2_128 = _mm256_set_epi64x(
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial),
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial));
+
+		__m256i CRCVec2 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[0]);
+		__m256i CRCVec3 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[1]);
+
+		Data = Data.subspan(64);
+
+		for( ; Data.size() >= 128; Data = Data.subspan(128) )
+		{
+			const __m256i MulLo0
+				= _mm256_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0000'0000);
+			const __m256i MulLo1
+				= _mm256_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0000'0000);
+			const __m256i MulLo2
+				= _mm256_clmulepi64_epi128(CRCVec2, K1K2_128, 0b0000'0000);
+			const __m256i MulLo3
+				= _mm256_clmulepi64_epi128(CRCVec3, K1K2_128, 0b0000'0000);
+
+			const __m256i MulHi0
+				= _mm256_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0001'0001);
+			const __m256i MulHi1
+				= _mm256_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0001'0001);
+			const __m256i MulHi2
+				= _mm256_clmulepi64_epi128(CRCVec2, K1K2_128, 0b0001'0001);
+			const __m256i MulHi3
+				= _mm256_clmulepi64_epi128(CRCVec3, K1K2_128, 0b0001'0001);
+
+			const __m256i Load0 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[0]);
+			const __m256i Load1 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[1]);
+			const __m256i Load2 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[2]);
+			const __m256i Load3 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[3]);
+
+			CRCVec0 = _mm256_xor_si256(_mm256_xor_si256(MulHi0, MulLo0), Load0);
+			CRCVec1 = _mm256_xor_si256(_mm256_xor_si256(MulHi1, MulLo1), Load1);
+			CRCVec2 = _mm256_xor_si256(_mm256_xor_si256(MulHi2, MulLo2), Load2);
+			CRCVec3 = _mm256_xor_si256(_mm256_xor_si256(MulHi3, MulLo3), Load3);
+		}
+
+		// Fold Vec0 and Vec1 across 64 bytes into Vec2 and Vec3
+		const __m256i K1K2_64 = _mm256_set_epi64x(
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+
+		CRCVec0 = _mm256_xor_si256(
+			_mm256_xor_si256(
+				_mm256_clmulepi64_epi128(CRCVec0, K1K2_64, 0b0001'0001),
+				_mm256_clmulepi64_epi128(CRCVec0, K1K2_64, 0b0000'0000)),
+			CRCVec2);
+		CRCVec1 = _mm256_xor_si256(
+			_mm256_xor_si256(
+				_mm256_clmulepi64_epi128(CRCVec1, K1K2_64, 0b0001'0001),
+				_mm256_clmulepi64_epi128(CRCVec1, K1K2_64, 0b0000'0000)),
+			CRCVec3);
+	}
+
+	// Fold 512 bits at a time
+	const __m256i K1K2 = _mm256_set_epi64x(
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m256i MulLo0
+			= _mm256_clmulepi64_epi128(CRCVec0, K1K2, 0b0000'0000);
+		const __m256i MulLo1
+			= _mm256_clmulepi64_epi128(CRCVec1, K1K2, 0b0000'0000);
+
+		const __m256i MulHi0
+			= _mm256_clmulepi64_epi128(CRCVec0, K1K2, 0b0001'0001);
+		const __m256i MulHi1
+			= _mm256_clmulepi64_epi128(CRCVec1, K1K2, 0b0001'0001);
+
+		const __m256i Load0 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[0]);
+		const __m256i Load1 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[1]);
+
+		CRCVec0 = _mm256_xor_si256(_mm256_xor_si256(MulHi0, MulLo0), Load0);
+		CRCVec1 = _mm256_xor_si256(_mm256_xor_si256(MulHi1, MulLo1), Load1);
+	}
+
+	CRCVec0_128 = _mm256_castsi256_si128(CRCVec0);
+	CRCVec1_128 = _mm256_extracti128_si256(CRCVec0, 1);
+	CRCVec2_128 = _mm256_castsi256_si128(CRCVec1);
+	CRCVec3_128 = _mm256_extracti128_si256(CRCVec1, 1);
+
+	return Data;
+}
+
+template<std::uint32_t Polynomial>
+TARGET_VPCLMULQDQ_256 std::uint32_t
+	CRC32_VPCLMULQDQ_256(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		return CRC32_PCLMULQDQ<Polynomial>(Data, CRC);
+	}
+
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi32_si128(CRC));
+
+	Data = CRC32_VPCLMULQDQ_256_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	return CRC32_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
+
+// Three-way exclusive-or, as a single `vpternlogq`
+#define TERNLOG_XOR3 0x96
+
+// The lane extracts of GCC 12 pass undefined sources, then warn about them
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+template<std::uint32_t Polynomial>
+TARGET_VPCLMULQDQ std::span<const std::byte> CRC32_VPCLMULQDQ_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0_128, __m128i& CRCVec1_128,
+	__m128i& CRCVec2_128, __m128i& CRCVec3_128)
+{
+	__m512i CRCVec_512 = _mm512_inserti32x4(
+		_mm512_inserti32x4(
+			_mm512_inserti32x4(
+				_mm512_castsi128_si512(CRCVec0_128), CRCVec1_128, 1),
+			CRCVec2_128, 2),
+		CRCVec3_128, 3);
+
+	// Fold 2048 bits at a time, with four independent accumulators so that
+	// the latency of each carry-less multiply is hidden behind the others
+	if( Data.size() >= 192 )
+	{
+		const __m512i K1K2_256 = _mm512_set_epi64(
+			KnConstant(256 - 4, Polynomial), KnConstant(256 + 4, Polynomial),
+			KnConstant(256 - 4, Polynomial), KnConstant(256 + 4, Polynomial),
+			KnConstant(256 - 4, Polynomial), KnConstant(256 + 4, Polynomial),
+			KnConstant(256 - 4, Polynomial), KnConstant(256 + 4, Polynomial));
+
+		__m512i CRCVec0 = CRCVec_512;
+		__m512i CRCVec1 = _mm512_loadu_si512(Data.data() + 0);
+		__m512i CRCVec2 = _mm512_loadu_si512(Data.data() + 64);
+		__m512i CRCVec3 = _mm512_loadu_si512(Data.data() + 128);
+
+		Data = Data.subspan(192);
+
+		for( ; Data.size() >= 256; Data = Data.subspan(256) )
+		{
+			const __m512i MulLo0
+				= _mm512_clmulepi64_epi128(CRCVec0, K1K2_256, 0b0000'0000);
+			const __m512i MulLo1
+				= _mm512_clmulepi64_epi128(CRCVec1, K1K2_256, 0b0000'0000);
+			const __m512i MulLo2
+				= _mm512_clmulepi64_epi128(CRCVec2, K1K2_256, 0b0000'0000);
+			const __m512i MulLo3
+				= _mm512_clmulepi64_epi128(CRCVec3, K1K2_256, 0b0000'0000);
+
+			const __m512i MulHi0
+				= _mm512_clmulepi64_epi128(CRCVec0, K1K2_256, 0b0001'0001);
+			const __m512i MulHi1
+				= _mm512_clmulepi64_epi128(CRCVec1, K1K2_256, 0b0001'0001);
+			const __m512i MulHi2
+				= _mm512_clmulepi64_epi128(CRCVec2, K1K2_256, 0b0001'0001);
+			const __m512i MulHi3
+				= _mm512_clmulepi64_epi128(CRCVec3, K1K2_256, 0b0001'0001);
+
+			CRCVec0 = _mm512_ternarylogic_epi64(
+				MulHi0, MulLo0, _mm512_loadu_si512(Data.data() + 0),
+				TERNLOG_XOR3);
+			CRCVec1 = _mm512_ternarylogic_epi64(
+				MulHi1, MulLo1, _mm512_loadu_si512(Data.data() + 64),
+				TERNLOG_XOR3);
+			CRCVec2 = _mm512_ternarylogic_epi64(
+				MulHi2, MulLo2, _mm512_loadu_si512(Data.data() + 128),
+				TERNLOG_XOR3);
+			CRCVec3 = _mm512_ternarylogic_epi64(
+				MulHi3, MulLo3, _mm512_loadu_si512(Data.data() + 192),
+				TERNLOG_XOR3);
+		}
+
+		// Tree-reduce the four accumulators, folding Vec0 and Vec1 across 128
+		// bytes into Vec2 and Vec3, and then Vec2 across 64 bytes into Vec3
+		const __m512i K1K2_128 = _mm512_set_epi64(
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial),
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial),
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial),
+			KnConstant(128 - 4, Polynomial), KnConstant(128 + 4, Polynomial));
+
+		CRCVec2 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0000'0000), CRCVec2,
+			TERNLOG_XOR3);
+		CRCVec3 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0000'0000), CRCVec3,
+			TERNLOG_XOR3);
+
+		const __m512i K1K2_64 = _mm512_set_epi64(
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+			KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+
+		CRCVec_512 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec2, K1K2_64, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec2, K1K2_64, 0b0000'0000), CRCVec3,
+			TERNLOG_XOR3);
+	}
+
+	// Fold 512 bits at a time
+	const __m512i K1K2 = _mm512_set_epi64(
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial),
+		KnConstant(64 - 4, Polynomial), KnConstant(64 + 4, Polynomial));
+
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m512i MulLo
+			= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0000'0000);
+
+		const __m512i MulHi
+			= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0001'0001);
+
+		const __m512i Load = _mm512_loadu_si512(Data.data());
+
+		CRCVec_512
+			= _mm512_ternarylogic_epi64(MulHi, MulLo, Load, TERNLOG_XOR3);
+	}
+
+	CRCVec0_128 = _mm512_extracti32x4_epi32(CRCVec_512, 0);
+	CRCVec1_128 = _mm512_extracti32x4_epi32(CRCVec_512, 1);
+	CRCVec2_128 = _mm512_extracti32x4_epi32(CRCVec_512, 2);
+	CRCVec3_128 = _mm512_extracti32x4_epi32(CRCVec_512, 3);
+
+	return Data;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+template<std::uint32_t Polynomial>
+TARGET_VPCLMULQDQ std::uint32_t
+	CRC32_VPCLMULQDQ(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		return CRC32_PCLMULQDQ<Polynomial>(Data, CRC);
+	}
+
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi32_si128(CRC));
+
+	Data = CRC32_VPCLMULQDQ_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	return CRC32_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
+
+using CRC32KernelT
+	= std::uint32_t (*)(std::span<const std::byte> Data, std::uint32_t CRC);
+
+// Each polynomial gets its own instantiation of the folding kernels, with all
+// of its folding and Barrett-reduction constants resolved at compile time
+static CRC32KernelT GetCRC32_PCLMULQDQ(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32KernelT GetCRC32_VPCLMULQDQ_256(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_VPCLMULQDQ_256<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_VPCLMULQDQ_256<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_VPCLMULQDQ_256<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_VPCLMULQDQ_256<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_VPCLMULQDQ_256<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32KernelT GetCRC32_VPCLMULQDQ(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_VPCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_VPCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_VPCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_VPCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_VPCLMULQDQ<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+using CRC32BatchKernelT = void (*)(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t>                    CRCs);
+
+static CRC32BatchKernelT GetCRC32_PCLMULQDQ_Batch(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PCLMULQDQ_Batch<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PCLMULQDQ_Batch<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PCLMULQDQ_Batch<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PCLMULQDQ_Batch<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PCLMULQDQ_Batch<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+// Kernels that fold whole 64-byte blocks into four 128-bit accumulators,
+// which are only reduced into a CRC once all of the input has been folded
+using CRC32FoldKernelT = std::span<const std::byte> (*)(
+	std::span<const std::byte> Data, __m128i& CRCVec0, __m128i& CRCVec1,
+	__m128i& CRCVec2, __m128i& CRCVec3);
+
+using CRC32ReduceKernelT = std::uint32_t (*)(
+	std::span<const std::byte> Data, __m128i CRCVec0, __m128i CRCVec1,
+	__m128i CRCVec2, __m128i CRCVec3);
+
+static CRC32FoldKernelT GetCRC32_PCLMULQDQ_Fold(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32FoldKernelT GetCRC32_VPCLMULQDQ_256_Fold(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_VPCLMULQDQ_256_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_VPCLMULQDQ_256_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_VPCLMULQDQ_256_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_VPCLMULQDQ_256_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_VPCLMULQDQ_256_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32FoldKernelT GetCRC32_VPCLMULQDQ_Fold(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_VPCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_VPCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_VPCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_VPCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_VPCLMULQDQ_Fold<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+static CRC32ReduceKernelT GetCRC32_PCLMULQDQ_Reduce(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return CRC32_PCLMULQDQ_Reduce<
+			BitReverse32(std::uint32_t(Polynomial::CRC32))>;
+	case Polynomial::CRC32C:
+		return CRC32_PCLMULQDQ_Reduce<
+			BitReverse32(std::uint32_t(Polynomial::CRC32C))>;
+	case Polynomial::CRC32K:
+		return CRC32_PCLMULQDQ_Reduce<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K))>;
+	case Polynomial::CRC32K2:
+		return CRC32_PCLMULQDQ_Reduce<
+			BitReverse32(std::uint32_t(Polynomial::CRC32K2))>;
+	case Polynomial::CRC32Q:
+		return CRC32_PCLMULQDQ_Reduce<
+			BitReverse32(std::uint32_t(Polynomial::CRC32Q))>;
+	}
+}
+
+// Runs three independent `crc32` streams over consecutive blocks to hide the
+// latency of the instruction. The first two streams are then shifted across the
+// blocks that follow them with a carry-less multiply by x^(8n-33) mod P(x) and
+// a final `crc32` reduction, and merged into the third.
+template<std::size_t BlockSize>
+TARGET_PCLMULQDQ std::span<const std::byte>
+	CRC32C_SSE42_Interleave(std::span<const std::byte> Data, std::uint32_t& CRC)
+{
+	static_assert(BlockSize % 8 == 0);
+
+	constexpr std::uint32_t Polynomial
+		= BitReverse32(std::uint32_t(Polynomial::CRC32C));
+
+	const __m128i K = _mm_set_epi64x(
+		KnConstant(BlockSize - 4, Polynomial),
+		KnConstant(BlockSize * 2 - 4, Polynomial));
+
+	for( ; Data.size() >= BlockSize * 3; Data = Data.subspan(BlockSize * 3) )
+	{
+		const std::byte* Block0 = Data.data() + BlockSize * 0;
+		const std::byte* Block1 = Data.data() + BlockSize * 1;
+		const std::byte* Block2 = Data.data() + BlockSize * 2;
+
+		std::uint64_t CRC0 = CRC;
+		std::uint64_t CRC1 = 0;
+		std::uint64_t CRC2 = 0;
+
+		for( std::size_t i = 0; i < BlockSize; i += sizeof(std::uint64_t) )
+		{
+			CRC0 = _mm_crc32_u64(
+				CRC0, *reinterpret_cast<const std::uint64_t*>(Block0 + i));
+			CRC1 = _mm_crc32_u64(
+				CRC1, *reinterpret_cast<const std::uint64_t*>(Block1 + i));
+			CRC2 = _mm_crc32_u64(
+				CRC2, *reinterpret_cast<const std::uint64_t*>(Block2 + i));
+		}
+
+		const __m128i Mul0
+			= _mm_clmulepi64_si128(_mm_cvtsi64_si128(CRC0), K, 0b0000'0000);
+		const __m128i Mul1
+			= _mm_clmulepi64_si128(_mm_cvtsi64_si128(CRC1), K, 0b0001'0000);
+
+		CRC = _mm_crc32_u64(0, _mm_cvtsi128_si64(_mm_xor_si128(Mul0, Mul1)))
+			^ CRC2;
+	}
+	return Data;
+}
+
+TARGET_PCLMULQDQ static std::uint32_t
+	CRC32C_SSE42(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	Data = CRC32C_SSE42_Interleave<4096>(Data, CRC);
+	Data = CRC32C_SSE42_Interleave<256>(Data, CRC);
+
+	std::uint64_t CRC64 = CRC;
+	for( ; Data.size() / 8; Data = Data.subspan(sizeof(std::uint64_t)) )
+	{
+		CRC64 = _mm_crc32_u64(
+			CRC64, *reinterpret_cast<const std::uint64_t*>(Data.data()));
+	}
+	CRC = std::uint32_t(CRC64);
+
+	for( ; Data.size(); Data = Data.subspan(sizeof(std::uint8_t)) )
+	{
+		CRC = _mm_crc32_u8(CRC, std::uint8_t(Data.front()));
+	}
+	return CRC;
+}
+
+TARGET_AVX2 inline std::uint32_t _mm256_hxor_epi32(__m256i a)
+{
+	// Xor top half with bottom half
+	const __m128i XorReduce128 = _mm_xor_si128(
+		_mm256_extracti128_si256(a, 1), _mm256_castsi256_si128(a));
+	const std::uint64_t XorReduce64 = _mm_extract_epi64(XorReduce128, 1)
+									^ _mm_extract_epi64(XorReduce128, 0);
+	return XorReduce64 ^ (XorReduce64 >> 32);
+}
+
+// Slice by 16
+static std::span<const std::byte> CRC32_Slice16(
+	std::span<const std::byte> Data, std::uint32_t& CRC,
+	const CRC32TableT& Table)
+{
+	for( ; Data.size() / 16; )
+	{
+		const std::uint32_t InputLoLo
+			= *reinterpret_cast<const std::uint32_t*>(Data.data()) ^ CRC;
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		const std::uint32_t InputHiLo
+			= *reinterpret_cast<const std::uint32_t*>(Data.data());
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		const std::uint32_t InputLoHi
+			= *reinterpret_cast<const std::uint32_t*>(Data.data());
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		const std::uint32_t InputHiHi
+			= *reinterpret_cast<const std::uint32_t*>(Data.data());
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		CRC = Table[15][std::uint8_t(InputLoLo)]
+			^ Table[14][std::uint8_t(InputLoLo >> 8)]
+			^ Table[13][std::uint8_t(InputLoLo >> 16)]
+			^ Table[12][std::uint8_t(InputLoLo >> 24)]
+			^ Table[11][std::uint8_t(InputHiLo)]
+			^ Table[10][std::uint8_t(InputHiLo >> 8)]
+			^ Table[9][std::uint8_t(InputHiLo >> 16)]
+			^ Table[8][std::uint8_t(InputHiLo >> 24)]
+			^ Table[7][std::uint8_t(InputLoHi)]
+			^ Table[6][std::uint8_t(InputLoHi >> 8)]
+			^ Table[5][std::uint8_t(InputLoHi >> 16)]
+			^ Table[4][std::uint8_t(InputLoHi >> 24)]
+			^ Table[3][std::uint8_t(InputHiHi)]
+			^ Table[2][std::uint8_t(InputHiHi >> 8)]
+			^ Table[1][std::uint8_t(InputHiHi >> 16)]
+			^ Table[0][std::uint8_t(InputHiHi >> 24)];
+	}
+	return Data;
+}
+
+// GCC 12 warns of the undefined vector its unmasked gather merges into
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+TARGET_AVX512 static std::span<const std::byte> CRC32_Slice16_AVX512(
+	std::span<const std::byte> Data, std::uint32_t& CRC,
+	const CRC32TableT& Table)
+{
+	const __m512i ByteIndex = _mm512_set_epi8(
+		~0, ~0, ~0, 15, ~0, ~0, ~0, 14, ~0, ~0, ~0, 13, ~0, ~0, ~0, 12, ~0, ~0,
+		~0, 11, ~0, ~0, ~0, 10, ~0, ~0, ~0, 9, ~0, ~0, ~0, 8, ~0, ~0, ~0, 7, ~0,
+		~0, ~0, 6, ~0, ~0, ~0, 5, ~0, ~0, ~0, 4, ~0, ~0, ~0, 3, ~0, ~0, ~0, 2,
+		~0, ~0, ~0, 1, ~0, ~0, ~0, 0);
+	// Offset into the multi-dimensional array
+	const __m512i ArrayOffset = _mm512_set_epi32(
+		(sizeof(CRC32TableT::value_type) / 4) * 0,
+		(sizeof(CRC32TableT::value_type) / 4) * 1,
+		(sizeof(CRC32TableT::value_type) / 4) * 2,
+		(sizeof(CRC32TableT::value_type) / 4) * 3,
+		(sizeof(CRC32TableT::value_type) / 4) * 4,
+		(sizeof(CRC32TableT::value_type) / 4) * 5,
+		(sizeof(CRC32TableT::value_type) / 4) * 6,
+		(sizeof(CRC32TableT::value_type) / 4) * 7,
+		(sizeof(CRC32TableT::value_type) / 4) * 8,
+		(sizeof(CRC32TableT::value_type) / 4) * 9,
+		(sizeof(CRC32TableT::value_type) / 4) * 10,
+		(sizeof(CRC32TableT::value_type) / 4) * 11,
+		(sizeof(CRC32TableT::value_type) / 4) * 12,
+		(sizeof(CRC32TableT::value_type) / 4) * 13,
+		(sizeof(CRC32TableT::value_type) / 4) * 14,
+		(sizeof(CRC32TableT::value_type) / 4) * 15);
+	for( ; Data.size() / 16; )
+	{
+		// Load in 8 bytes
+		const std::uint64_t Input64Lo
+			= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
+		Data = Data.subspan(sizeof(std::uint64_t));
+		const std::uint64_t Input64Hi
+			= *reinterpret_cast<const std::uint64_t*>(Data.data());
+		Data = Data.subspan(sizeof(std::uint64_t));
+		// Spread out each byte into a eight 32-bit lanes, in each 256-bit
+		// lane
+		const __m512i Indices = _mm512_shuffle_epi8(
+			_mm512_unpacklo_epi64(
+				_mm512_set1_epi64(Input64Lo), _mm512_set1_epi64(Input64Hi)),
+			ByteIndex);
+		// Use the spread out bytes to gather
+		const __m512i Gather = _mm512_i32gather_epi32(
+			_mm512_add_epi32(Indices, ArrayOffset),
+			reinterpret_cast<const std::int32_t*>(Table.data()),
+			sizeof(std::uint32_t));
+		CRC = _mm256_hxor_epi32(_mm256_xor_si256(
+			_mm512_castsi512_si256(Gather),
+			_mm512_extracti32x8_epi32(Gather, 1)));
+	}
+	return Data;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Slice by 8
+static std::span<const std::byte> CRC32_Slice8(
+	std::span<const std::byte> Data, std::uint32_t& CRC,
+	const CRC32TableT& Table)
+{
+	for( ; Data.size() / 8; )
+	{
+		const std::uint32_t InputLo
+			= *reinterpret_cast<const std::uint32_t*>(Data.data()) ^ CRC;
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		const std::uint32_t InputHi
+			= *reinterpret_cast<const std::uint32_t*>(Data.data());
+		Data = Data.subspan(sizeof(std::uint32_t));
+
+		CRC = Table[7][std::uint8_t(InputLo)]
+			^ Table[6][std::uint8_t(InputLo >> 8)]
+			^ Table[5][std::uint8_t(InputLo >> 16)]
+			^ Table[4][std::uint8_t(InputLo >> 24)]
+			^ Table[3][std::uint8_t(InputHi)]
+			^ Table[2][std::uint8_t(InputHi >> 8)]
+			^ Table[1][std::uint8_t(InputHi >> 16)]
+			^ Table[0][std::uint8_t(InputHi >> 24)];
+	}
+	return Data;
+}
+
+TARGET_AVX2 static std::span<const std::byte> CRC32_Slice8_AVX2(
+	std::span<const std::byte> Data, std::uint32_t& CRC,
+	const CRC32TableT& Table)
+{
+	const __m256i ByteIndex = _mm256_set_epi8(
+		~0, ~0, ~0, 7, ~0, ~0, ~0, 6, ~0, ~0, ~0, 5, ~0, ~0, ~0, 4, ~0, ~0, ~0,
+		3, ~0, ~0, ~0, 2, ~0, ~0, ~0, 1, ~0, ~0, ~0, 0);
+	// Offset into the multi-dimensional array
+	const __m256i ArrayOffset = _mm256_set_epi32(
+		(sizeof(CRC32TableT::value_type) / 4) * 0,
+		(sizeof(CRC32TableT::value_type) / 4) * 1,
+		(sizeof(CRC32TableT::value_type) / 4) * 2,
+		(sizeof(CRC32TableT::value_type) / 4) * 3,
+		(sizeof(CRC32TableT::value_type) / 4) * 4,
+		(sizeof(CRC32TableT::value_type) / 4) * 5,
+		(sizeof(CRC32TableT::value_type) / 4) * 6,
+		(sizeof(CRC32TableT::value_type) / 4) * 7);
+	for( ; Data.size() / 8; )
+	{
+		// Load in 8 bytes
+		const std::uint64_t Input64
+			= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
+		Data = Data.subspan(sizeof(std::uint64_t));
+		// Spread out each byte into a eight 32-bit lanes
+		const __m256i Indices
+			= _mm256_shuffle_epi8(_mm256_set1_epi64x(Input64), ByteIndex);
+		// Use the spread out bytes to gather
+		const __m256i Gather = _mm256_i32gather_epi32(
+			reinterpret_cast<const std::int32_t*>(Table.data()),
+			_mm256_add_epi32(Indices, ArrayOffset), sizeof(std::uint32_t));
+		CRC = _mm256_hxor_epi32(Gather);
+	}
+	return Data;
+}
+
+static std::uint32_t CRC32_Slice1(
+	std::span<const std::byte> Data, std::uint32_t CRC,
+	const CRC32TableT& Table)
+{
+	return std::accumulate(
+		Data.begin(), Data.end(), CRC,
+		[&Table](std::uint32_t CurCRC, std::byte Byte) -> std::uint32_t {
+			return (CurCRC >> 8)
+				 ^ Table[0][std::uint8_t(CurCRC) ^ std::uint8_t(Byte)];
+		});
+}
+
+// Checksum implementations, from the most portable to the most specialized
+static std::uint32_t Checksum_Table(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	const auto& Table = GetCRC32Table(Poly);
+
+	Data = CRC32_Slice16(Data, CRC, Table);
+	Data = CRC32_Slice8(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+TARGET_AVX2 static std::uint32_t Checksum_AVX2(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	const auto& Table = GetCRC32Table(Poly);
+
+	Data = CRC32_Slice16(Data, CRC, Table);
+	Data = CRC32_Slice8_AVX2(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+TARGET_AVX512 static std::uint32_t Checksum_AVX512(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	const auto& Table = GetCRC32Table(Poly);
+
+	Data = CRC32_Slice16_AVX512(Data, CRC, Table);
+	Data = CRC32_Slice8_AVX2(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+TARGET_PCLMULQDQ static std::uint32_t Checksum_PCLMULQDQ(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	if( Poly == Polynomial::CRC32C )
+	{
+		return CRC32C_SSE42(Data, CRC);
+	}
+
+	return GetCRC32_PCLMULQDQ(Poly)(Data, CRC);
+}
+
+TARGET_VPCLMULQDQ_256 static std::uint32_t Checksum_VPCLMULQDQ_256(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	// The `crc32` instruction is still faster for CRC32C inputs that are too
+	// short to fold
+	if( Poly == Polynomial::CRC32C && Data.size() < 64 )
+	{
+		return CRC32C_SSE42(Data, CRC);
+	}
+
+	return GetCRC32_VPCLMULQDQ_256(Poly)(Data, CRC);
+}
+
+TARGET_VPCLMULQDQ static std::uint32_t Checksum_VPCLMULQDQ(
+	std::span<const std::byte> Data, std::uint32_t CRC, Polynomial Poly)
+{
+	if( Poly == Polynomial::CRC32C && Data.size() < 64 )
+	{
+		return CRC32C_SSE42(Data, CRC);
+	}
+
+	return GetCRC32_VPCLMULQDQ(Poly)(Data, CRC);
+}
+
+// Instruction-set tiers of the implementations above
+enum class ChecksumTier
+{
+	Table,
+	AVX2,
+	AVX512,
+	PCLMULQDQ,
+	VPCLMULQDQ_256,
+	VPCLMULQDQ,
+};
+
+static bool IsTierSupported(ChecksumTier Tier)
+{
+	__builtin_cpu_init();
+
+	const bool HasAVX2   = __builtin_cpu_supports("avx2");
+	const bool HasAVX512 = __builtin_cpu_supports("avx512f")
+						&& __builtin_cpu_supports("avx512bw")
+						&& __builtin_cpu_supports("avx512dq")
+						&& __builtin_cpu_supports("avx512vl");
+	const bool HasPCLMULQDQ
+		= __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul");
+	const bool HasVPCLMULQDQ = __builtin_cpu_supports("vpclmulqdq");
+
+	switch( Tier )
+	{
+	default:
+	case ChecksumTier::Table:
+		return true;
+	case ChecksumTier::AVX2:
+		return HasAVX2;
+	case ChecksumTier::AVX512:
+		return HasAVX512;
+	case ChecksumTier::PCLMULQDQ:
+		return HasPCLMULQDQ;
+	case ChecksumTier::VPCLMULQDQ_256:
+		return HasAVX2 && HasPCLMULQDQ && HasVPCLMULQDQ;
+	case ChecksumTier::VPCLMULQDQ:
+		return HasAVX512 && HasPCLMULQDQ && HasVPCLMULQDQ;
+	}
+}
+
+// The implementation of each tier, in the same order
+static constexpr ChecksumKernel TierKernels[] = {
+	{"Table", Checksum_Table},
+	{"AVX2", Checksum_AVX2},
+	{"AVX512", Checksum_AVX512},
+	{"PCLMULQDQ", Checksum_PCLMULQDQ},
+	{"VPCLMULQDQ_256", Checksum_VPCLMULQDQ_256},
+	{"VPCLMULQDQ", Checksum_VPCLMULQDQ},
+};
+
+// The most specialized of the tiers that the host supports
+static ChecksumTier SelectChecksumTier()
+{
+	for( std::size_t i = std::size(TierKernels); i-- > 0; )
+	{
+		if( IsTierSupported(ChecksumTier(i)) )
+		{
+			return ChecksumTier(i);
+		}
+	}
+	return ChecksumTier::Table;
+}
+
+// Resolved once, upon first use
+static ChecksumTier GetChecksumTier()
+{
+	static const ChecksumTier Tier = SelectChecksumTier();
+	return Tier;
+}
+
+static std::vector<ChecksumKernel> SelectChecksumKernels()
+{
+	std::vector<ChecksumKernel> Kernels;
+	for( std::size_t i = 0; i < std::size(TierKernels); ++i )
+	{
+		if( IsTierSupported(ChecksumTier(i)) )
+		{
+			Kernels.push_back(TierKernels[i]);
+		}
+	}
+	return Kernels;
+}
+
+// Resolved once, upon first use
+std::span<const ChecksumKernel> GetChecksumKernels()
+{
+	static const std::vector<ChecksumKernel> Kernels = SelectChecksumKernels();
+	return Kernels;
+}
+
+std::string GetHostIdentity()
+{
+	std::uint32_t MaxLeaf = 0, Vendor[3] = {};
+	__get_cpuid(0, &MaxLeaf, &Vendor[0], &Vendor[2], &Vendor[1]);
+
+	// Family, model, and stepping, along with the feature flags of leaf 1 and
+	// the extended feature flags of leaf 7. The rest of leaf 1 differs from
+	// one core to the next, so it is left out.
+	std::uint32_t Signature = 0, Features1C = 0, Features1D = 0;
+	std::uint32_t Features7B = 0, Features7C = 0, Unused[3] = {};
+	__get_cpuid(1, &Signature, &Unused[0], &Features1C, &Features1D);
+	if( MaxLeaf >= 7 )
+	{
+		__cpuid_count(7, 0, Unused[1], Features7B, Features7C, Unused[2]);
+	}
+
+	char Identity[96] = {};
+	std::snprintf(
+		Identity, sizeof(Identity), "%.12s %08x %08x:%08x:%08x:%08x",
+		reinterpret_cast<const char*>(Vendor), Signature, Features1C,
+		Features1D, Features7B, Features7C);
+	return Identity;
+}
+
+std::uint32_t Checksum(
+	std::span<const std::byte> Data, std::uint32_t InitialValue,
+	Polynomial Poly)
+{
+	return ~GetChecksumKernel(Poly, Data.size())(Data, ~InitialValue, Poly);
+}
+
+// Compile-time specialized implementations, which resolve the tables, fold
+// constants, and kernel of a polynomial known ahead of time
+template<Polynomial Poly>
+static std::uint32_t
+	ChecksumStatic_Table(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	const auto& Table = CRC32TableStatic<Poly>()();
+
+	Data = CRC32_Slice16(Data, CRC, Table);
+	Data = CRC32_Slice8(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+template<Polynomial Poly>
+TARGET_AVX2 static std::uint32_t
+	ChecksumStatic_AVX2(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	const auto& Table = CRC32TableStatic<Poly>()();
+
+	Data = CRC32_Slice16(Data, CRC, Table);
+	Data = CRC32_Slice8_AVX2(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+template<Polynomial Poly>
+TARGET_AVX512 static std::uint32_t
+	ChecksumStatic_AVX512(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	const auto& Table = CRC32TableStatic<Poly>()();
+
+	Data = CRC32_Slice16_AVX512(Data, CRC, Table);
+	Data = CRC32_Slice8_AVX2(Data, CRC, Table);
+	return CRC32_Slice1(Data, CRC, Table);
+}
+
+template<Polynomial Poly>
+TARGET_PCLMULQDQ static std::uint32_t
+	ChecksumStatic_PCLMULQDQ(std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if constexpr( Poly == Polynomial::CRC32C )
+	{
+		return CRC32C_SSE42(Data, CRC);
+	}
+	else
+	{
+		return CRC32_PCLMULQDQ<BitReverse32(std::uint32_t(Poly))>(Data, CRC);
+	}
+}
+
+template<Polynomial Poly>
+TARGET_VPCLMULQDQ_256 static std::uint32_t ChecksumStatic_VPCLMULQDQ_256(
+	std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if constexpr( Poly == Polynomial::CRC32C )
+	{
+		if( Data.size() < 64 )
+		{
+			return CRC32C_SSE42(Data, CRC);
+		}
+		return CRC32_VPCLMULQDQ_256<BitReverse32(std::uint32_t(Poly))>(
+			Data, CRC);
+	}
+	else
+	{
+		return CRC32_VPCLMULQDQ_256<BitReverse32(std::uint32_t(Poly))>(
+			Data, CRC);
+	}
+}
+
+template<Polynomial Poly>
+TARGET_VPCLMULQDQ static std::uint32_t ChecksumStatic_VPCLMULQDQ(
+	std::span<const std::byte> Data, std::uint32_t CRC)
+{
+	if constexpr( Poly == Polynomial::CRC32C )
+	{
+		if( Data.size() < 64 )
+		{
+			return CRC32C_SSE42(Data, CRC);
+		}
+		return CRC32_VPCLMULQDQ<BitReverse32(std::uint32_t(Poly))>(Data, CRC);
+	}
+	else
+	{
+		return CRC32_VPCLMULQDQ<BitReverse32(std::uint32_t(Poly))>(Data, CRC);
+	}
+}
+
+template<Polynomial Poly>
+static CRC32KernelT SelectChecksumStatic()
+{
+	switch( GetChecksumTier() )
+	{
+	default:
+	case ChecksumTier::Table:
+		return ChecksumStatic_Table<Poly>;
+	case ChecksumTier::AVX2:
+		return ChecksumStatic_AVX2<Poly>;
+	case ChecksumTier::AVX512:
+		return ChecksumStatic_AVX512<Poly>;
+	case ChecksumTier::PCLMULQDQ:
+		return ChecksumStatic_PCLMULQDQ<Poly>;
+	case ChecksumTier::VPCLMULQDQ_256:
+		return ChecksumStatic_VPCLMULQDQ_256<Poly>;
+	case ChecksumTier::VPCLMULQDQ:
+		return ChecksumStatic_VPCLMULQDQ<Poly>;
+	}
+}
+
+template<Polynomial Poly>
+std::uint32_t
+	Checksum(std::span<const std::byte> Data, std::uint32_t InitialValue)
+{
+	static const CRC32KernelT ChecksumImpl = SelectChecksumStatic<Poly>();
+	return ~ChecksumImpl(Data, ~InitialValue);
+}
+
+template std::uint32_t Checksum<Polynomial::CRC32>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32C>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32K>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32K2>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+template std::uint32_t Checksum<Polynomial::CRC32Q>(
+	std::span<const std::byte> Data, std::uint32_t InitialValue);
+
+// Batched checksum implementations
+using ChecksumBatchT = void (*)(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t> CRCs, Polynomial Poly);
+
+static void ChecksumBatch_Serial(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t> CRCs, Polynomial Poly)
+{
+	for( std::size_t i = 0; i < Inputs.size(); ++i )
+	{
+		CRCs[i] = GetChecksumKernel(Poly, Inputs[i].size())(
+			Inputs[i], CRCs[i], Poly);
+	}
+}
+
+TARGET_PCLMULQDQ static void ChecksumBatch_PCLMULQDQ(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t> CRCs, Polynomial Poly)
+{
+	const CRC32BatchKernelT Kernel = GetCRC32_PCLMULQDQ_Batch(Poly);
+
+	for( std::size_t i = 0; i < Inputs.size(); i += BatchLanes )
+	{
+		const std::size_t Count = std::min(BatchLanes, Inputs.size() - i);
+		Kernel(Inputs.subspan(i, Count), CRCs.subspan(i, Count));
+	}
+
+	for( std::size_t i = 0; i < Inputs.size(); ++i )
+	{
+		if( Inputs[i].size() >= BatchInputSize )
+		{
+			CRCs[i] = GetChecksumKernel(Poly, Inputs[i].size())(
+				Inputs[i], CRCs[i], Poly);
+		}
+	}
+}
+
+static ChecksumBatchT SelectChecksumBatch()
+{
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul") )
+	{
+		return ChecksumBatch_PCLMULQDQ;
+	}
+	return ChecksumBatch_Serial;
+}
+
+void Checksum(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<std::uint32_t> Checksums, Polynomial Poly)
+{
+	static const ChecksumBatchT ChecksumBatchImpl = SelectChecksumBatch();
+
+	Checksums = Checksums.first(Inputs.size());
+
+	std::fill(Checksums.begin(), Checksums.end(), ~0u);
+	ChecksumBatchImpl(Inputs, Checksums, Poly);
+	for( std::uint32_t& CurChecksum : Checksums )
+	{
+		CurChecksum = ~CurChecksum;
+	}
+}
+
+// Streaming implementations. A Hasher folds with the folding kernels of
+// whichever tier's kernel Checksum uses for the largest inputs, as chosen by a
+// profile, or updates the CRC register directly if that tier has none. Each
+// entry is named after the kernel of its tier.
+using HasherFoldT = CRC32FoldKernelT (*)(Polynomial Poly);
+
+struct HasherFold
+{
+	std::string_view Name;
+	HasherFoldT      GetFold;
+};
+
+static constexpr HasherFold HasherFolds[] = {
+	{"Table", nullptr},
+	{"AVX2", nullptr},
+	{"AVX512", nullptr},
+	{"PCLMULQDQ", GetCRC32_PCLMULQDQ_Fold},
+	{"VPCLMULQDQ_256", GetCRC32_VPCLMULQDQ_256_Fold},
+	{"VPCLMULQDQ", GetCRC32_VPCLMULQDQ_Fold},
+};
+
+// Index within HasherFolds of the kernel that Checksum uses for the largest
+// inputs of Poly
+static std::uint8_t SelectHasherFold(Polynomial Poly)
+{
+	const ChecksumT Kernel
+		= GetChecksumKernel(Poly, std::numeric_limits<std::size_t>::max());
+	for( const ChecksumKernel& CurKernel : GetChecksumKernels() )
+	{
+		if( CurKernel.Checksum != Kernel )
+		{
+			continue;
+		}
+		for( std::size_t i = 0; i < std::size(HasherFolds); ++i )
+		{
+			if( HasherFolds[i].Name == CurKernel.Name )
+			{
+				return std::uint8_t(i);
+			}
+		}
+	}
+	return 0;
+}
+
+// Folds Data into the 512-bit State of a Hasher
+static std::span<const std::byte> HasherFoldBlocks(
+	CRC32FoldKernelT Fold, std::span<const std::byte> Data,
+	std::span<std::byte, 64> State)
+{
+	__m128i* StateVec = reinterpret_cast<__m128i*>(State.data());
+
+	__m128i CRCVec0 = _mm_load_si128(&StateVec[0]);
+	__m128i CRCVec1 = _mm_load_si128(&StateVec[1]);
+	__m128i CRCVec2 = _mm_load_si128(&StateVec[2]);
+	__m128i CRCVec3 = _mm_load_si128(&StateVec[3]);
+
+	Data = Fold(Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	_mm_store_si128(&StateVec[0], CRCVec0);
+	_mm_store_si128(&StateVec[1], CRCVec1);
+	_mm_store_si128(&StateVec[2], CRCVec2);
+	_mm_store_si128(&StateVec[3], CRCVec3);
+
+	return Data;
+}
+
+Hasher::Hasher(Polynomial HasherPoly, std::uint32_t InitialValue)
+	: Poly(HasherPoly), CRC(~InitialValue), FoldKernel(SelectHasherFold(Poly))
+{
+	// The fold state starts out as a 64-byte block that ends with the initial
+	// CRC, shifted back across itself
+	const std::uint32_t Prefix = UnshiftCRC32(CRC, Poly);
+
+	FoldState.fill(std::byte{0});
+	std::memcpy(
+		FoldState.data() + FoldState.size() - sizeof(Prefix), &Prefix,
+		sizeof(Prefix));
+}
+
+void Hasher::Update(std::span<const std::byte> Data)
+{
+	const HasherFoldT GetFold = HasherFolds[FoldKernel].GetFold;
+
+	if( !GetFold )
+	{
+		CRC = GetChecksumKernel(Poly, Data.size())(Data, CRC, Poly);
+		return;
+	}
+
+	const CRC32FoldKernelT Fold = GetFold(Poly);
+
+	// Complete the block left over from the previous update first
+	if( CarrySize )
+	{
+		const std::size_t Count = std::min(64 - CarrySize, Data.size());
+		std::memcpy(Carry.data() + 16 + CarrySize, Data.data(), Count);
+		CarrySize += Count;
+		Data = Data.subspan(Count);
+
+		if( CarrySize < 64 )
+		{
+			return;
+		}
+
+		HasherFoldBlocks(Fold, std::span(Carry).subspan(16), FoldState);
+		CarrySize = 0;
+	}
+
+	if( Data.size() >= 64 )
+	{
+		Data = HasherFoldBlocks(Fold, Data, FoldState);
+	}
+
+	std::memcpy(Carry.data() + 16, Data.data(), Data.size());
+	CarrySize = Data.size();
+}
+
+std::uint32_t Hasher::Finalize() const
+{
+	if( !HasherFolds[FoldKernel].GetFold )
+	{
+		return ~CRC;
+	}
+
+	const __m128i* StateVec
+		= reinterpret_cast<const __m128i*>(FoldState.data());
+
+	return ~GetCRC32_PCLMULQDQ_Reduce(Poly)(
+		std::span(Carry).subspan(16, CarrySize), _mm_load_si128(&StateVec[0]),
+		_mm_load_si128(&StateVec[1]), _mm_load_si128(&StateVec[2]),
+		_mm_load_si128(&StateVec[3]));
+}
+
+} // namespace CRC
+
+#endif
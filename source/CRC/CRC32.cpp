@@ -0,0 +1,368 @@
+#include <CRC32.hpp>
+
+#include "CRC32-Kernels.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CRC
+{
+
+// Multiplies two bit-reflected polynomials modulo P(x)
+static constexpr std::uint32_t
+	MultiplyModP(std::uint32_t A, std::uint32_t B, std::uint32_t Polynomial)
+{
+	std::uint32_t Product = 0;
+	for( std::uint32_t Mask = 1u << 31; Mask; Mask >>= 1 )
+	{
+		if( A & Mask )
+		{
+			Product ^= B;
+		}
+		B = (B >> 1) ^ (-(B & 0b1) & Polynomial); // b *= x
+	}
+	return Product;
+}
+
+// x^(8 * 2^n) mod P(x) for each bit of a 64-bit byte count
+using XPowTableT = std::array<std::uint32_t, 64>;
+
+constexpr XPowTableT XPowTable(std::uint32_t Polynomial) noexcept
+{
+	XPowTableT Table = {};
+	Table[0]         = (1u << 31) >> 8; // x^8
+	for( std::size_t i = 1; i < Table.size(); ++i )
+	{
+		Table[i] = MultiplyModP(Table[i - 1], Table[i - 1], Polynomial);
+	}
+	return Table;
+}
+
+template<Polynomial Poly>
+struct XPowTableStatic
+{
+	const XPowTableT& operator()() const
+	{
+		static constexpr XPowTableT Table = XPowTable(std::uint32_t(Poly));
+		return Table;
+	}
+};
+
+static const XPowTableT& GetXPowTable(Polynomial Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial::CRC32:
+		return XPowTableStatic<Polynomial::CRC32>()();
+	case Polynomial::CRC32C:
+		return XPowTableStatic<Polynomial::CRC32C>()();
+	case Polynomial::CRC32K:
+		return XPowTableStatic<Polynomial::CRC32K>()();
+	case Polynomial::CRC32K2:
+		return XPowTableStatic<Polynomial::CRC32K2>()();
+	case Polynomial::CRC32Q:
+		return XPowTableStatic<Polynomial::CRC32Q>()();
+	}
+}
+
+// Multiplies CRC by x^(8n) mod P(x), with one multiply for each set bit of n
+static std::uint32_t
+	ShiftBytes(std::uint32_t CRC, std::uint64_t Length, Polynomial Poly)
+{
+	const auto& Table = GetXPowTable(Poly);
+	for( std::size_t i = 0; Length; Length >>= 1, ++i )
+	{
+		if( Length & 0b1 )
+		{
+			CRC = MultiplyModP(CRC, Table[i], std::uint32_t(Poly));
+		}
+	}
+	return CRC;
+}
+
+std::uint32_t ChecksumSegments(
+	std::span<const std::span<const std::byte>> Segments,
+	std::uint32_t InitialValue, Polynomial Poly)
+{
+	Hasher SegmentHasher(Poly, InitialValue);
+	for( const std::span<const std::byte>& CurSegment : Segments )
+	{
+		SegmentHasher.Update(CurSegment);
+	}
+	return SegmentHasher.Finalize();
+}
+
+std::uint32_t ChecksumZeros(
+	std::uint64_t Length, std::uint32_t InitialValue, Polynomial Poly)
+{
+	// Each zero byte just multiplies the CRC register by x^8
+	return ~ShiftBytes(~InitialValue, Length, Poly);
+}
+
+std::uint32_t Combine(
+	std::uint32_t CRCA, std::uint32_t CRCB, std::uint64_t LengthB,
+	Polynomial Poly)
+{
+	// The pre and post-inversion of each CRC cancel out, leaving just the
+	// shifted CRC of the first span
+	return ShiftBytes(CRCA, LengthB, Poly) ^ CRCB;
+}
+
+// Names of each polynomial within a profile
+static constexpr std::pair<std::string_view, Polynomial> PolynomialNames[] = {
+	{"crc32", Polynomial::CRC32},   {"crc32c", Polynomial::CRC32C},
+	{"crc32k", Polynomial::CRC32K}, {"crc32k2", Polynomial::CRC32K2},
+	{"crc32q", Polynomial::CRC32Q},
+};
+
+static std::size_t PolynomialIndex(Polynomial Poly)
+{
+	for( std::size_t i = 0; i < std::size(PolynomialNames); ++i )
+	{
+		if( PolynomialNames[i].second == Poly )
+		{
+			return i;
+		}
+	}
+	return 0;
+}
+
+// The kernel of each size class of each polynomial. Atomic, so that a profile
+// may be loaded while other threads are hashing.
+struct KernelTable
+{
+	KernelTable()
+	{
+		const ChecksumT DefaultKernel = GetChecksumKernels().back().Checksum;
+		for( auto& CurPolynomial : Kernels )
+		{
+			for( auto& CurKernel : CurPolynomial )
+			{
+				CurKernel.store(DefaultKernel, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	std::array<
+		std::array<std::atomic<ChecksumT>, SizeClassCount>,
+		std::size(PolynomialNames)>
+		Kernels;
+};
+
+static KernelTable& GetKernelTable()
+{
+	static KernelTable Table;
+	return Table;
+}
+
+ChecksumT GetChecksumKernel(Polynomial Poly, std::size_t Size)
+{
+	return GetKernelTable()
+		.Kernels[PolynomialIndex(Poly)][SizeClass(Size)]
+		.load(std::memory_order_relaxed);
+}
+
+// First line of every profile, to be bumped along with any change to the
+// meaning of the rest of it
+static constexpr std::string_view ProfileHeader = "qCheck-CRC32-profile 2";
+
+// The header, followed by the processor that the profile was measured upon.
+// Kernel timings of one processor say nothing of another's, even when both
+// support the same kernels.
+static std::string GetProfileHeader()
+{
+	return std::string(ProfileHeader) + ' ' + GetHostIdentity();
+}
+
+// Fastest time, in seconds, that Kernel takes to checksum Data a number of
+// times over, across several attempts
+static double MeasureKernel(
+	ChecksumT Kernel, std::span<const std::byte> Data, Polynomial Poly)
+{
+	// Enough repetitions for even the smallest inputs to take a measurable
+	// amount of time
+	const std::size_t Repeats = std::max<std::size_t>(
+		1, (256 * 1024) / std::max<std::size_t>(Data.size(), 1));
+
+	double        BestTime = std::numeric_limits<double>::infinity();
+	std::uint32_t CRC      = 0;
+	for( std::size_t i = 0; i < 5; ++i )
+	{
+		const auto StartTime = std::chrono::steady_clock::now();
+		for( std::size_t j = 0; j < Repeats; ++j )
+		{
+			CRC = Kernel(Data, CRC, Poly);
+		}
+		const std::chrono::duration<double> Elapsed
+			= std::chrono::steady_clock::now() - StartTime;
+		BestTime = std::min(BestTime, Elapsed.count());
+	}
+
+	// Keeps the checksums from being optimized away
+	__asm__ volatile("" : : "r"(CRC));
+
+	return BestTime;
+}
+
+std::string Calibrate()
+{
+	const std::span<const ChecksumKernel> Kernels = GetChecksumKernels();
+
+	// The largest inputs stand in for all of the last size class
+	std::vector<std::byte> Data(1024 * 1024);
+	std::mt19937           MersenneTwister;
+	for( std::byte& CurByte : Data )
+	{
+		CurByte = std::byte(MersenneTwister());
+	}
+
+	KernelTable& Table = GetKernelTable();
+
+	std::string Profile = GetProfileHeader();
+	Profile += '\n';
+	for( std::size_t i = 0; i < std::size(PolynomialNames); ++i )
+	{
+		const auto& [PolynomialName, Poly] = PolynomialNames[i];
+
+		Profile += PolynomialName;
+		for( std::size_t CurClass = 0; CurClass < SizeClassCount; ++CurClass )
+		{
+			// Measured at the largest size of each class
+			const std::size_t Size = CurClass + 1 < SizeClassCount
+									   ? std::size_t(16) << (CurClass * 2)
+									   : Data.size();
+
+			const ChecksumKernel* Fastest = &Kernels.back();
+			double BestTime = std::numeric_limits<double>::infinity();
+			for( const ChecksumKernel& CurKernel : Kernels )
+			{
+				const double Time = MeasureKernel(
+					CurKernel.Checksum, std::span(Data).first(Size), Poly);
+				if( Time < BestTime )
+				{
+					Fastest  = &CurKernel;
+					BestTime = Time;
+				}
+			}
+
+			Table.Kernels[i][CurClass].store(
+				Fastest->Checksum, std::memory_order_relaxed);
+
+			Profile += ' ';
+			Profile += Fastest->Name;
+		}
+		Profile += '\n';
+	}
+	return Profile;
+}
+
+// Splits off the first word of String, up to the first space
+static std::string_view NextWord(std::string_view& String)
+{
+	const std::size_t      BreakPos = String.find(' ');
+	const std::string_view Word     = String.substr(0, BreakPos);
+	String.remove_prefix(
+		BreakPos == std::string_view::npos ? String.size() : BreakPos + 1);
+	return Word;
+}
+
+bool LoadProfile(std::string_view Profile)
+{
+	const std::span<const ChecksumKernel> Kernels = GetChecksumKernels();
+
+	constexpr std::size_t PolynomialCount = std::size(PolynomialNames);
+
+	std::array<std::array<ChecksumT, SizeClassCount>, PolynomialCount>
+		ProfileKernels = {};
+	std::array<bool, PolynomialCount> Present = {};
+
+	const std::string Header = GetProfileHeader();
+
+	// Nothing is changed until all of the profile has been read
+	bool HeaderRead = false;
+	while( !Profile.empty() )
+	{
+		const std::size_t LineEnd = Profile.find('\n');
+		std::string_view  Line    = Profile.substr(0, LineEnd);
+		Profile.remove_prefix(
+			LineEnd == std::string_view::npos ? Profile.size() : LineEnd + 1);
+
+		if( Line.empty() )
+		{
+			continue;
+		}
+
+		if( !HeaderRead )
+		{
+			if( Line != Header )
+			{
+				return false;
+			}
+			HeaderRead = true;
+			continue;
+		}
+
+		const std::string_view PolynomialName = NextWord(Line);
+		const auto             CurPolynomial  = std::find_if(
+			std::begin(PolynomialNames), std::end(PolynomialNames),
+			[PolynomialName](const auto& Entry) -> bool {
+				return Entry.first == PolynomialName;
+			});
+		if( CurPolynomial == std::end(PolynomialNames) )
+		{
+			return false;
+		}
+		const std::size_t CurIndex
+			= CurPolynomial - std::begin(PolynomialNames);
+
+		for( std::size_t CurClass = 0; CurClass < SizeClassCount; ++CurClass )
+		{
+			const std::string_view KernelName = NextWord(Line);
+			const auto             CurKernel  = std::find_if(
+				Kernels.begin(), Kernels.end(),
+				[KernelName](const ChecksumKernel& Kernel) -> bool {
+					return Kernel.Name == KernelName;
+				});
+			// Profiles of other hosts may name kernels that this one lacks
+			if( CurKernel == Kernels.end() )
+			{
+				return false;
+			}
+			ProfileKernels[CurIndex][CurClass] = CurKernel->Checksum;
+		}
+		if( !Line.empty() )
+		{
+			return false;
+		}
+		Present[CurIndex] = true;
+	}
+
+	if( !HeaderRead )
+	{
+		return false;
+	}
+
+	KernelTable& Table = GetKernelTable();
+	for( std::size_t i = 0; i < std::size(PolynomialNames); ++i )
+	{
+		if( !Present[i] )
+		{
+			continue;
+		}
+		for( std::size_t CurClass = 0; CurClass < SizeClassCount; ++CurClass )
+		{
+			Table.Kernels[i][CurClass].store(
+				ProfileKernels[i][CurClass], std::memory_order_relaxed);
+		}
+	}
+	return true;
+}
+
+} // namespace CRC
@@ -0,0 +1,390 @@
+#if defined(__aarch64__)
+
+#include <CRC64.hpp>
+
+#include <array>
+
+#include <arm_neon.h>
+
+namespace CRC
+{
+
+using CRC64TableT = std::array<std::array<std::uint64_t, 256>, 8>;
+
+constexpr CRC64TableT CRC64Table(std::uint64_t Polynomial) noexcept
+{
+	CRC64TableT Table = {};
+	// Generate main table
+	for( std::size_t i = 0; i < 256; ++i )
+	{
+		std::uint64_t CRC = i;
+		for( std::size_t CurBit = 0; CurBit < 8; ++CurBit )
+		{
+			CRC = (CRC >> 1) ^ (-(CRC & 0b1) & Polynomial);
+		}
+		Table[0][i] = CRC;
+	}
+	// Generate additional tables based on the main table
+	for( std::size_t j = 1; j < Table.size(); ++j )
+	{
+		for( std::size_t i = 0; i < 256; ++i )
+		{
+			const std::uint64_t Prev = Table[j - 1][i];
+			Table[j][i] = (Prev >> 8) ^ Table[0][std::uint8_t(Prev)];
+		}
+	}
+
+	return Table;
+}
+
+template<Polynomial64 Poly>
+struct CRC64TableStatic
+{
+	const CRC64TableT& operator()() const
+	{
+		static constexpr CRC64TableT Table = CRC64Table(std::uint64_t(Poly));
+		return Table;
+	}
+};
+
+static const CRC64TableT& GetCRC64Table(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64TableStatic<Polynomial64::ECMA182>()();
+	case Polynomial64::NVMe:
+		return CRC64TableStatic<Polynomial64::NVMe>()();
+	}
+}
+
+consteval std::uint64_t BitReverse64(std::uint64_t Value)
+{
+	std::uint64_t Reversed = 0;
+	for( std::uint32_t BitIndex = 0u; BitIndex < 64u; ++BitIndex )
+	{
+		Reversed = (Reversed << 1u) + (Value & 0b1);
+		Value >>= 1u;
+	}
+	return Reversed;
+}
+
+// BitReverse(x^(shift) mod P(x)), carried out in the bit-reflected domain
+consteval std::uint64_t
+	KnConstant64(std::uint32_t BitShift, std::uint64_t Polynomial)
+{
+	std::uint64_t Remainder = 1ull << 63; // x^0
+	for( std::uint32_t i = 0; i < BitShift; ++i )
+	{
+		Remainder = (Remainder >> 1) ^ (-(Remainder & 0b1) & Polynomial);
+	}
+	return Remainder;
+}
+
+// Multipliers for the low and high 64 bits of a 128-bit fold accumulator, that
+// fold it across the ByteShift bytes that follow it. The carry-less product of
+// two bit-reflected values comes out multiplied by x, which is taken out here.
+consteval std::uint64_t
+	KnConstantLo(std::uint32_t ByteShift, std::uint64_t Polynomial)
+{
+	return KnConstant64(8 * ByteShift + 64 - 1, Polynomial);
+}
+
+consteval std::uint64_t
+	KnConstantHi(std::uint32_t ByteShift, std::uint64_t Polynomial)
+{
+	return KnConstant64(8 * ByteShift - 1, Polynomial);
+}
+
+// BitReverse(x^128 / P(x)), without its x^0 term
+consteval std::uint64_t MuConstant64(std::uint64_t Polynomial)
+{
+	const std::uint64_t Divisor   = BitReverse64(Polynomial);
+	std::uint64_t       Remainder = 0u;
+	std::uint64_t       Quotient  = 0u;
+	for( std::size_t i = 0; i <= 128; ++i )
+	{
+		const std::uint64_t Overflow = Remainder >> 63u;
+		Remainder                    = (Remainder << 1u) | (i == 0);
+		if( Overflow )
+		{
+			Remainder ^= Divisor;
+		}
+		if( i >= 64 && i < 128 )
+		{
+			Quotient |= Overflow << (i - 64);
+		}
+	}
+	return Quotient;
+}
+
+#define ECMAPOLY 0xC96C5795D7870F42
+
+// clang-format off
+static_assert(KnConstantLo(16, ECMAPOLY) == 0xE05DD497CA393AE4);
+static_assert(KnConstantHi(16, ECMAPOLY) == 0xDABE95AFC7875F40);
+static_assert(MuConstant64(    ECMAPOLY) == 0x9C3E466C172963D5);
+// clang-format on
+
+#if defined(__ARM_FEATURE_AES)
+// Simulates the behavior of the `_mm_clmulepi64_si128` instruction found on x64
+template<std::size_t LaneB, std::size_t LaneA>
+inline poly64x2_t pmull_p64(const poly64x2_t OpA, const poly64x2_t OpB)
+{
+	return (poly64x2_t)vmull_p64(
+		vgetq_lane_u64(OpA, LaneA), vgetq_lane_u64(OpB, LaneB));
+}
+
+template<>
+inline poly64x2_t pmull_p64<1, 1>(const poly64x2_t OpA, const poly64x2_t OpB)
+{
+	return (poly64x2_t)vmull_high_p64(OpA, OpB);
+}
+
+inline poly64x2_t
+	eor3_p64(const poly64x2_t OpA, const poly64x2_t OpB, const poly64x2_t OpC)
+{
+#if defined(__ARM_FEATURE_SHA3)
+	return veor3q_u64(OpA, OpB, OpC);
+#else
+	return veorq_u64(OpA, veorq_u64(OpB, OpC));
+#endif
+}
+
+// Sliding window of `tbl` indices. Sixteen indices loaded from an offset of
+// (16 - n) shift a vector left by n bytes, and from an offset of (16 + n) shift
+// it right by n bytes, with the vacated bytes set to zero.
+alignas(16) static constexpr std::array<std::uint8_t, 48> ByteShiftTable = {
+	// clang-format off
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	// clang-format on
+};
+
+inline uint8x16_t ByteShiftIndices(std::ptrdiff_t Offset)
+{
+	return vld1q_u8(ByteShiftTable.data() + Offset);
+}
+
+// Reduces a 128-bit fold accumulator into a 64-bit CRC
+template<std::uint64_t Polynomial>
+inline std::uint64_t CRC64_PMULL_Barrett(poly64x2_t CRCVec0)
+{
+	const uint64x2_t Zero = vdupq_n_u64(0);
+
+	// Fold the low 64 bits across the high 64 bits, leaving a 128-bit
+	// remainder that is congruent to the CRC
+	const poly64x2_t K3 = poly64x2_t{
+		KnConstantHi(16, Polynomial),
+		0ull,
+	};
+
+	CRCVec0 = veorq_u64(
+		pmull_p64<0, 0>(CRCVec0, K3), vextq_u8(CRCVec0, Zero, 8));
+
+	// Reduce 128 to 64
+	const poly64x2_t Poly = poly64x2_t{
+		MuConstant64(Polynomial),
+		(Polynomial << 1) | 1,
+	};
+
+	const poly64x2_t Quotient = pmull_p64<0, 0>(CRCVec0, Poly);
+	const poly64x2_t Product  = pmull_p64<1, 0>(Quotient, Poly);
+
+	return vgetq_lane_u64(Product, 1) ^ vgetq_lane_u64(Quotient, 0)
+		 ^ vgetq_lane_u64(CRCVec0, 1);
+}
+
+// Folds the remaining 16-byte blocks of Data into a 128-bit accumulator and
+// reduces it into a 64-bit CRC. A final partial block is handled by re-loading
+// the last 16 bytes of the input, so at least 16 bytes must precede Data.
+template<std::uint64_t Polynomial>
+inline std::uint64_t
+	CRC64_PMULL_Fold16(std::span<const std::byte> Data, poly64x2_t CRCVec0)
+{
+	const poly64x2_t K3K4 = poly64x2_t{
+		KnConstantLo(16, Polynomial),
+		KnConstantHi(16, Polynomial),
+	};
+
+	// Fold 128 bits at a time
+	for( ; Data.size() >= 16; Data = Data.subspan(16) )
+	{
+		const poly64x2_t Load
+			= vld1q_p64(reinterpret_cast<const poly64_t*>(Data.data()));
+
+		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec0, K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec0, K3K4);
+		CRCVec0                = eor3_p64(MulHi, MulLo, Load);
+	}
+
+	// The first n bytes of the accumulator are folded across the 16 bytes that
+	// follow them, which are the rest of the accumulator and the last n bytes
+	// of input
+	if( const std::ptrdiff_t Remainder = Data.size(); Remainder )
+	{
+		const uint8x16_t Last16 = vld1q_u8(
+			reinterpret_cast<const std::uint8_t*>(Data.data()) + Remainder
+			- 16);
+
+		const uint8x16_t ShiftRight = ByteShiftIndices(16 + Remainder);
+
+		const uint8x16_t Accumulator = vreinterpretq_u8_p64(CRCVec0);
+
+		const poly64x2_t Head = vreinterpretq_p64_u8(
+			vqtbl1q_u8(Accumulator, ByteShiftIndices(Remainder)));
+		const poly64x2_t Tail = vreinterpretq_p64_u8(vbslq_u8(
+			vcgeq_u8(ShiftRight, vdupq_n_u8(0x80)), Last16,
+			vqtbl1q_u8(Accumulator, ShiftRight)));
+
+		const poly64x2_t MulLo = pmull_p64<0, 0>(Head, K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(Head, K3K4);
+		CRCVec0                = eor3_p64(MulHi, MulLo, Tail);
+	}
+
+	return CRC64_PMULL_Barrett<Polynomial>(CRCVec0);
+}
+
+// Needs at least 16 bytes of input
+template<std::uint64_t Polynomial>
+std::uint64_t CRC64_PMULL(std::span<const std::byte> Data, std::uint64_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		const poly64x2_t CRCVec0 = veorq_u64(
+			vld1q_p64(reinterpret_cast<const poly64_t*>(Data.data())),
+			vsetq_lane_u64(CRC, vdupq_n_u64(0), 0));
+		return CRC64_PMULL_Fold16<Polynomial>(Data.subspan(16), CRCVec0);
+	}
+
+	poly64x2x4_t CRCVec
+		= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(Data.data()));
+
+	Data = Data.subspan(64);
+
+	CRCVec.val[0]
+		= veorq_u64(CRCVec.val[0], vsetq_lane_u64(CRC, vdupq_n_u64(0), 0));
+
+	// Fold 512 bits at a time
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const poly64x2_t K1K2 = poly64x2_t{
+			KnConstantLo(64, Polynomial),
+			KnConstantHi(64, Polynomial),
+		};
+
+		const poly64x2_t MulLo0 = pmull_p64<0, 0>(CRCVec.val[0], K1K2);
+		const poly64x2_t MulLo1 = pmull_p64<0, 0>(CRCVec.val[1], K1K2);
+		const poly64x2_t MulLo2 = pmull_p64<0, 0>(CRCVec.val[2], K1K2);
+		const poly64x2_t MulLo3 = pmull_p64<0, 0>(CRCVec.val[3], K1K2);
+
+		const poly64x2_t MulHi0 = pmull_p64<1, 1>(CRCVec.val[0], K1K2);
+		const poly64x2_t MulHi1 = pmull_p64<1, 1>(CRCVec.val[1], K1K2);
+		const poly64x2_t MulHi2 = pmull_p64<1, 1>(CRCVec.val[2], K1K2);
+		const poly64x2_t MulHi3 = pmull_p64<1, 1>(CRCVec.val[3], K1K2);
+
+		const poly64x2x4_t Load
+			= vld1q_p64_x4(reinterpret_cast<const poly64_t*>(Data.data()));
+
+		CRCVec.val[0] = eor3_p64(MulHi0, MulLo0, Load.val[0]);
+		CRCVec.val[1] = eor3_p64(MulHi1, MulLo1, Load.val[1]);
+		CRCVec.val[2] = eor3_p64(MulHi2, MulLo2, Load.val[2]);
+		CRCVec.val[3] = eor3_p64(MulHi3, MulLo3, Load.val[3]);
+	}
+
+	// Reduce 512 to 128
+	const poly64x2_t K3K4 = poly64x2_t{
+		KnConstantLo(16, Polynomial),
+		KnConstantHi(16, Polynomial),
+	};
+
+	// Reduce Vec1 into Vec0
+	{
+		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec.val[0], K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec.val[0], K3K4);
+		CRCVec.val[0]          = eor3_p64(MulHi, MulLo, CRCVec.val[1]);
+	}
+
+	// Reduce Vec2 into Vec0
+	{
+		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec.val[0], K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec.val[0], K3K4);
+		CRCVec.val[0]          = eor3_p64(MulHi, MulLo, CRCVec.val[2]);
+	}
+
+	// Reduce Vec3 into Vec0
+	{
+		const poly64x2_t MulLo = pmull_p64<0, 0>(CRCVec.val[0], K3K4);
+		const poly64x2_t MulHi = pmull_p64<1, 1>(CRCVec.val[0], K3K4);
+		CRCVec.val[0]          = eor3_p64(MulHi, MulLo, CRCVec.val[3]);
+	}
+
+	return CRC64_PMULL_Fold16<Polynomial>(Data, CRCVec.val[0]);
+}
+
+using CRC64KernelT
+	= std::uint64_t (*)(std::span<const std::byte> Data, std::uint64_t CRC);
+
+// Each polynomial gets its own instantiation of the folding kernel, with all of
+// its folding and Barrett-reduction constants resolved at compile time
+static CRC64KernelT GetCRC64_PMULL(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64_PMULL<std::uint64_t(Polynomial64::ECMA182)>;
+	case Polynomial64::NVMe:
+		return CRC64_PMULL<std::uint64_t(Polynomial64::NVMe)>;
+	}
+}
+#endif
+
+std::uint64_t Checksum64(
+	std::span<const std::byte> Data, std::uint64_t InitialValue,
+	Polynomial64 Poly)
+{
+	std::uint64_t CRC = ~InitialValue;
+
+#if defined(__ARM_FEATURE_AES)
+	if( Data.size() >= 16 )
+	{
+		return ~GetCRC64_PMULL(Poly)(Data, CRC);
+	}
+#endif
+
+	const auto& Table = GetCRC64Table(Poly);
+
+	// Slice by 8
+	for( ; Data.size() / 8; )
+	{
+		const std::uint64_t Input
+			= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
+		Data = Data.subspan(sizeof(std::uint64_t));
+
+		CRC = Table[7][std::uint8_t(Input)]
+			^ Table[6][std::uint8_t(Input >> 8)]
+			^ Table[5][std::uint8_t(Input >> 16)]
+			^ Table[4][std::uint8_t(Input >> 24)]
+			^ Table[3][std::uint8_t(Input >> 32)]
+			^ Table[2][std::uint8_t(Input >> 40)]
+			^ Table[1][std::uint8_t(Input >> 48)]
+			^ Table[0][std::uint8_t(Input >> 56)];
+	}
+
+	for( const std::byte& CurByte : Data )
+	{
+		CRC = (CRC >> 8) ^ Table[0][std::uint8_t(CRC) ^ std::uint8_t(CurByte)];
+	}
+
+	return ~CRC;
+}
+
+} // namespace CRC
+
+#endif
@@ -0,0 +1,793 @@
+#if defined(_M_X64) || defined(__amd64__)
+
+#include <CRC64.hpp>
+
+#include <array>
+
+#include <x86intrin.h>
+
+namespace CRC
+{
+
+using CRC64TableT = std::array<std::array<std::uint64_t, 256>, 8>;
+
+constexpr CRC64TableT CRC64Table(std::uint64_t Polynomial) noexcept
+{
+	CRC64TableT Table = {};
+	// Generate main table
+	for( std::size_t i = 0; i < 256; ++i )
+	{
+		std::uint64_t CRC = i;
+		for( std::size_t CurBit = 0; CurBit < 8; ++CurBit )
+		{
+			CRC = (CRC >> 1) ^ (-(CRC & 0b1) & Polynomial);
+		}
+		Table[0][i] = CRC;
+	}
+	// Generate additional tables based on the main table
+	for( std::size_t j = 1; j < Table.size(); ++j )
+	{
+		for( std::size_t i = 0; i < 256; ++i )
+		{
+			const std::uint64_t Prev = Table[j - 1][i];
+			Table[j][i] = (Prev >> 8) ^ Table[0][std::uint8_t(Prev)];
+		}
+	}
+
+	return Table;
+}
+
+template<Polynomial64 Poly>
+struct CRC64TableStatic
+{
+	const CRC64TableT& operator()() const
+	{
+		static constexpr CRC64TableT Table = CRC64Table(std::uint64_t(Poly));
+		return Table;
+	}
+};
+
+static const CRC64TableT& GetCRC64Table(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64TableStatic<Polynomial64::ECMA182>()();
+	case Polynomial64::NVMe:
+		return CRC64TableStatic<Polynomial64::NVMe>()();
+	}
+}
+
+consteval std::uint64_t BitReverse64(std::uint64_t Value)
+{
+	std::uint64_t Reversed = 0;
+	for( std::uint32_t BitIndex = 0u; BitIndex < 64u; ++BitIndex )
+	{
+		Reversed = (Reversed << 1u) + (Value & 0b1);
+		Value >>= 1u;
+	}
+	return Reversed;
+}
+
+// BitReverse(x^(shift) mod P(x)), carried out in the bit-reflected domain
+consteval std::uint64_t
+	KnConstant64(std::uint32_t BitShift, std::uint64_t Polynomial)
+{
+	std::uint64_t Remainder = 1ull << 63; // x^0
+	for( std::uint32_t i = 0; i < BitShift; ++i )
+	{
+		Remainder = (Remainder >> 1) ^ (-(Remainder & 0b1) & Polynomial);
+	}
+	return Remainder;
+}
+
+// Multipliers for the low and high 64 bits of a 128-bit fold accumulator, that
+// fold it across the ByteShift bytes that follow it. The carry-less product of
+// two bit-reflected values comes out multiplied by x, which is taken out here.
+consteval std::uint64_t
+	KnConstantLo(std::uint32_t ByteShift, std::uint64_t Polynomial)
+{
+	return KnConstant64(8 * ByteShift + 64 - 1, Polynomial);
+}
+
+consteval std::uint64_t
+	KnConstantHi(std::uint32_t ByteShift, std::uint64_t Polynomial)
+{
+	return KnConstant64(8 * ByteShift - 1, Polynomial);
+}
+
+// BitReverse(x^128 / P(x)), without its x^0 term
+consteval std::uint64_t MuConstant64(std::uint64_t Polynomial)
+{
+	const std::uint64_t Divisor   = BitReverse64(Polynomial);
+	std::uint64_t       Remainder = 0u;
+	std::uint64_t       Quotient  = 0u;
+	for( std::size_t i = 0; i <= 128; ++i )
+	{
+		const std::uint64_t Overflow = Remainder >> 63u;
+		Remainder                    = (Remainder << 1u) | (i == 0);
+		if( Overflow )
+		{
+			Remainder ^= Divisor;
+		}
+		if( i >= 64 && i < 128 )
+		{
+			Quotient |= Overflow << (i - 64);
+		}
+	}
+	return Quotient;
+}
+
+#define ECMAPOLY 0xC96C5795D7870F42
+
+// clang-format off
+static_assert(KnConstantLo(16, ECMAPOLY) == 0xE05DD497CA393AE4);
+static_assert(KnConstantHi(16, ECMAPOLY) == 0xDABE95AFC7875F40);
+static_assert(MuConstant64(    ECMAPOLY) == 0x9C3E466C172963D5);
+// clang-format on
+
+// Kernels are compiled for the instruction-set extensions that they need and
+// are selected at runtime based on the features of the host processor
+#define TARGET_PCLMULQDQ __attribute__((target("sse4.2,pclmul")))
+#define TARGET_VPCLMULQDQ_256                                                  \
+	__attribute__((target("sse4.2,pclmul,avx2,vpclmulqdq")))
+#define TARGET_VPCLMULQDQ                                                      \
+	__attribute__((target(                                                     \
+		"sse4.2,pclmul,avx2,avx512f,avx512bw,avx512dq,avx512vl,vpclmulqdq")))
+
+// Sliding window of `pshufb` indices. Sixteen indices loaded from an offset of
+// (16 - n) shift a vector left by n bytes, and from an offset of (16 + n) shift
+// it right by n bytes, with the vacated bytes set to zero.
+alignas(16) static constexpr std::array<std::uint8_t, 48> ByteShiftTable = {
+	// clang-format off
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	// clang-format on
+};
+
+TARGET_PCLMULQDQ inline __m128i ByteShiftIndices(std::ptrdiff_t Offset)
+{
+	return _mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(ByteShiftTable.data() + Offset));
+}
+
+// Reduces a 128-bit fold accumulator into a 64-bit CRC
+template<std::uint64_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint64_t CRC64_PCLMULQDQ_Barrett(__m128i CRCVec0)
+{
+	// Fold the low 64 bits across the high 64 bits, leaving a 128-bit
+	// remainder that is congruent to the CRC
+	const __m128i K3 = _mm_cvtsi64_si128(KnConstantHi(16, Polynomial));
+
+	CRCVec0 = _mm_xor_si128(
+		_mm_clmulepi64_si128(CRCVec0, K3, 0b0000'0000),
+		_mm_srli_si128(CRCVec0, 8));
+
+	// Reduce 128 to 64
+	const __m128i Poly = _mm_set_epi64x(
+		(Polynomial << 1) | 1, MuConstant64(Polynomial));
+
+	const __m128i Quotient = _mm_clmulepi64_si128(CRCVec0, Poly, 0b0000'0000);
+	const __m128i Product  = _mm_clmulepi64_si128(Quotient, Poly, 0b0001'0000);
+
+	return _mm_extract_epi64(
+		_mm_xor_si128(
+			_mm_xor_si128(Product, _mm_slli_si128(Quotient, 8)), CRCVec0),
+		1);
+}
+
+// Folds the remaining 16-byte blocks of Data into a 128-bit accumulator and
+// reduces it into a 64-bit CRC. A final partial block is handled by re-loading
+// the last 16 bytes of the input, so at least 16 bytes must precede Data.
+template<std::uint64_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint64_t
+	CRC64_PCLMULQDQ_Fold16(std::span<const std::byte> Data, __m128i CRCVec0)
+{
+	const __m128i K3K4 = _mm_set_epi64x(
+		KnConstantHi(16, Polynomial), KnConstantLo(16, Polynomial));
+
+	// Fold 128 bits at a time
+	for( ; Data.size() >= 16; Data = Data.subspan(16) )
+	{
+		const __m128i Load
+			= _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data.data()));
+
+		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
+
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Load);
+	}
+
+	// The first n bytes of the accumulator are folded across the 16 bytes that
+	// follow them, which are the rest of the accumulator and the last n bytes
+	// of input
+	if( const std::ptrdiff_t Remainder = Data.size(); Remainder )
+	{
+		const __m128i Last16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+			Data.data() + Remainder - 16));
+
+		const __m128i ShiftRight = ByteShiftIndices(16 + Remainder);
+
+		const __m128i Head
+			= _mm_shuffle_epi8(CRCVec0, ByteShiftIndices(Remainder));
+		const __m128i Tail = _mm_blendv_epi8(
+			_mm_shuffle_epi8(CRCVec0, ShiftRight), Last16, ShiftRight);
+
+		const __m128i MulLo = _mm_clmulepi64_si128(Head, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(Head, K3K4, 0b0001'0001);
+
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), Tail);
+	}
+
+	return CRC64_PCLMULQDQ_Barrett<Polynomial>(CRCVec0);
+}
+
+// Reduces four 128-bit fold accumulators into a 64-bit CRC, folding in the
+// rest of Data along the way
+template<std::uint64_t Polynomial>
+TARGET_PCLMULQDQ inline std::uint64_t CRC64_PCLMULQDQ_Reduce(
+	std::span<const std::byte> Data, __m128i CRCVec0, __m128i CRCVec1,
+	__m128i CRCVec2, __m128i CRCVec3)
+{
+	// Reduce 512 to 128
+	const __m128i K3K4 = _mm_set_epi64x(
+		KnConstantHi(16, Polynomial), KnConstantLo(16, Polynomial));
+
+	// Reduce Vec1 into Vec0
+	{
+		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), CRCVec1);
+	}
+
+	// Reduce Vec2 into Vec0
+	{
+		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), CRCVec2);
+	}
+
+	// Reduce Vec3 into Vec0
+	{
+		const __m128i MulLo = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0000'0000);
+		const __m128i MulHi = _mm_clmulepi64_si128(CRCVec0, K3K4, 0b0001'0001);
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi, MulLo), CRCVec3);
+	}
+
+	return CRC64_PCLMULQDQ_Fold16<Polynomial>(Data, CRCVec0);
+}
+
+// Folds every whole 64-byte block of Data into four 128-bit accumulators,
+// returning whatever is left over
+template<std::uint64_t Polynomial>
+TARGET_PCLMULQDQ std::span<const std::byte> CRC64_PCLMULQDQ_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0, __m128i& CRCVec1,
+	__m128i& CRCVec2, __m128i& CRCVec3)
+{
+	// Fold 512 bits at a time
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m128i K1K2 = _mm_set_epi64x(
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial));
+
+		const __m128i MulLo0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0000'0000);
+		const __m128i MulLo1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0000'0000);
+		const __m128i MulLo2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0000'0000);
+		const __m128i MulLo3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0000'0000);
+
+		const __m128i MulHi0 = _mm_clmulepi64_si128(CRCVec0, K1K2, 0b0001'0001);
+		const __m128i MulHi1 = _mm_clmulepi64_si128(CRCVec1, K1K2, 0b0001'0001);
+		const __m128i MulHi2 = _mm_clmulepi64_si128(CRCVec2, K1K2, 0b0001'0001);
+		const __m128i MulHi3 = _mm_clmulepi64_si128(CRCVec3, K1K2, 0b0001'0001);
+
+		const __m128i Load0 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[0]);
+		const __m128i Load1 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[1]);
+		const __m128i Load2 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[2]);
+		const __m128i Load3 = _mm_loadu_si128(
+			&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+		CRCVec0 = _mm_xor_si128(_mm_xor_si128(MulHi0, MulLo0), Load0);
+		CRCVec1 = _mm_xor_si128(_mm_xor_si128(MulHi1, MulLo1), Load1);
+		CRCVec2 = _mm_xor_si128(_mm_xor_si128(MulHi2, MulLo2), Load2);
+		CRCVec3 = _mm_xor_si128(_mm_xor_si128(MulHi3, MulLo3), Load3);
+	}
+
+	return Data;
+}
+
+template<std::uint64_t Polynomial>
+TARGET_PCLMULQDQ std::uint64_t
+	CRC64_PCLMULQDQ(std::span<const std::byte> Data, std::uint64_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		const __m128i CRCVec0 = _mm_xor_si128(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data.data())),
+			_mm_cvtsi64_si128(CRC));
+		return CRC64_PCLMULQDQ_Fold16<Polynomial>(Data.subspan(16), CRCVec0);
+	}
+
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi64_si128(CRC));
+
+	Data = CRC64_PCLMULQDQ_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	return CRC64_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
+
+// For processors with 256-bit carry-less multiplies but without AVX-512
+template<std::uint64_t Polynomial>
+TARGET_VPCLMULQDQ_256 std::span<const std::byte> CRC64_VPCLMULQDQ_256_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0_128, __m128i& CRCVec1_128,
+	__m128i& CRCVec2_128, __m128i& CRCVec3_128)
+{
+	__m256i CRCVec0 = _mm256_set_m128i(CRCVec1_128, CRCVec0_128);
+	__m256i CRCVec1 = _mm256_set_m128i(CRCVec3_128, CRCVec2_128);
+
+	// Fold 1024 bits at a time, with four independent accumulators
+	if( Data.size() >= 64 )
+	{
+		const __m256i K1K2_128 = _mm256_set_epi64x(
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial),
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial));
+
+		__m256i CRCVec2 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[0]);
+		__m256i CRCVec3 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[1]);
+
+		Data = Data.subspan(64);
+
+		for( ; Data.size() >= 128; Data = Data.subspan(128) )
+		{
+			const __m256i MulLo0
+				= _mm256_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0000'0000);
+			const __m256i MulLo1
+				= _mm256_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0000'0000);
+			const __m256i MulLo2
+				= _mm256_clmulepi64_epi128(CRCVec2, K1K2_128, 0b0000'0000);
+			const __m256i MulLo3
+				= _mm256_clmulepi64_epi128(CRCVec3, K1K2_128, 0b0000'0000);
+
+			const __m256i MulHi0
+				= _mm256_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0001'0001);
+			const __m256i MulHi1
+				= _mm256_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0001'0001);
+			const __m256i MulHi2
+				= _mm256_clmulepi64_epi128(CRCVec2, K1K2_128, 0b0001'0001);
+			const __m256i MulHi3
+				= _mm256_clmulepi64_epi128(CRCVec3, K1K2_128, 0b0001'0001);
+
+			const __m256i Load0 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[0]);
+			const __m256i Load1 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[1]);
+			const __m256i Load2 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[2]);
+			const __m256i Load3 = _mm256_loadu_si256(
+				&reinterpret_cast<const __m256i*>(Data.data())[3]);
+
+			CRCVec0 = _mm256_xor_si256(_mm256_xor_si256(MulHi0, MulLo0), Load0);
+			CRCVec1 = _mm256_xor_si256(_mm256_xor_si256(MulHi1, MulLo1), Load1);
+			CRCVec2 = _mm256_xor_si256(_mm256_xor_si256(MulHi2, MulLo2), Load2);
+			CRCVec3 = _mm256_xor_si256(_mm256_xor_si256(MulHi3, MulLo3), Load3);
+		}
+
+		// Fold Vec0 and Vec1 across 64 bytes into Vec2 and Vec3
+		const __m256i K1K2_64 = _mm256_set_epi64x(
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial));
+
+		CRCVec0 = _mm256_xor_si256(
+			_mm256_xor_si256(
+				_mm256_clmulepi64_epi128(CRCVec0, K1K2_64, 0b0001'0001),
+				_mm256_clmulepi64_epi128(CRCVec0, K1K2_64, 0b0000'0000)),
+			CRCVec2);
+		CRCVec1 = _mm256_xor_si256(
+			_mm256_xor_si256(
+				_mm256_clmulepi64_epi128(CRCVec1, K1K2_64, 0b0001'0001),
+				_mm256_clmulepi64_epi128(CRCVec1, K1K2_64, 0b0000'0000)),
+			CRCVec3);
+	}
+
+	// Fold 512 bits at a time
+	const __m256i K1K2 = _mm256_set_epi64x(
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial));
+
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m256i MulLo0
+			= _mm256_clmulepi64_epi128(CRCVec0, K1K2, 0b0000'0000);
+		const __m256i MulLo1
+			= _mm256_clmulepi64_epi128(CRCVec1, K1K2, 0b0000'0000);
+
+		const __m256i MulHi0
+			= _mm256_clmulepi64_epi128(CRCVec0, K1K2, 0b0001'0001);
+		const __m256i MulHi1
+			= _mm256_clmulepi64_epi128(CRCVec1, K1K2, 0b0001'0001);
+
+		const __m256i Load0 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[0]);
+		const __m256i Load1 = _mm256_loadu_si256(
+			&reinterpret_cast<const __m256i*>(Data.data())[1]);
+
+		CRCVec0 = _mm256_xor_si256(_mm256_xor_si256(MulHi0, MulLo0), Load0);
+		CRCVec1 = _mm256_xor_si256(_mm256_xor_si256(MulHi1, MulLo1), Load1);
+	}
+
+	CRCVec0_128 = _mm256_castsi256_si128(CRCVec0);
+	CRCVec1_128 = _mm256_extracti128_si256(CRCVec0, 1);
+	CRCVec2_128 = _mm256_castsi256_si128(CRCVec1);
+	CRCVec3_128 = _mm256_extracti128_si256(CRCVec1, 1);
+
+	return Data;
+}
+
+template<std::uint64_t Polynomial>
+TARGET_VPCLMULQDQ_256 std::uint64_t
+	CRC64_VPCLMULQDQ_256(std::span<const std::byte> Data, std::uint64_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		return CRC64_PCLMULQDQ<Polynomial>(Data, CRC);
+	}
+
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi64_si128(CRC));
+
+	Data = CRC64_VPCLMULQDQ_256_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	return CRC64_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
+
+// Three-way exclusive-or, as a single `vpternlogq`
+#define TERNLOG_XOR3 0x96
+
+// GCC 12 reports the undefined sources of its own lane extracts as unset
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+template<std::uint64_t Polynomial>
+TARGET_VPCLMULQDQ std::span<const std::byte> CRC64_VPCLMULQDQ_Fold(
+	std::span<const std::byte> Data, __m128i& CRCVec0_128, __m128i& CRCVec1_128,
+	__m128i& CRCVec2_128, __m128i& CRCVec3_128)
+{
+	__m512i CRCVec_512 = _mm512_inserti32x4(
+		_mm512_inserti32x4(
+			_mm512_inserti32x4(
+				_mm512_castsi128_si512(CRCVec0_128), CRCVec1_128, 1),
+			CRCVec2_128, 2),
+		CRCVec3_128, 3);
+
+	// Fold 2048 bits at a time, with four independent accumulators so that
+	// the latency of each carry-less multiply is hidden behind the others
+	if( Data.size() >= 192 )
+	{
+		const __m512i K1K2_256 = _mm512_set_epi64(
+			KnConstantHi(256, Polynomial), KnConstantLo(256, Polynomial),
+			KnConstantHi(256, Polynomial), KnConstantLo(256, Polynomial),
+			KnConstantHi(256, Polynomial), KnConstantLo(256, Polynomial),
+			KnConstantHi(256, Polynomial), KnConstantLo(256, Polynomial));
+
+		__m512i CRCVec0 = CRCVec_512;
+		__m512i CRCVec1 = _mm512_loadu_si512(Data.data() + 0);
+		__m512i CRCVec2 = _mm512_loadu_si512(Data.data() + 64);
+		__m512i CRCVec3 = _mm512_loadu_si512(Data.data() + 128);
+
+		Data = Data.subspan(192);
+
+		for( ; Data.size() >= 256; Data = Data.subspan(256) )
+		{
+			const __m512i MulLo0
+				= _mm512_clmulepi64_epi128(CRCVec0, K1K2_256, 0b0000'0000);
+			const __m512i MulLo1
+				= _mm512_clmulepi64_epi128(CRCVec1, K1K2_256, 0b0000'0000);
+			const __m512i MulLo2
+				= _mm512_clmulepi64_epi128(CRCVec2, K1K2_256, 0b0000'0000);
+			const __m512i MulLo3
+				= _mm512_clmulepi64_epi128(CRCVec3, K1K2_256, 0b0000'0000);
+
+			const __m512i MulHi0
+				= _mm512_clmulepi64_epi128(CRCVec0, K1K2_256, 0b0001'0001);
+			const __m512i MulHi1
+				= _mm512_clmulepi64_epi128(CRCVec1, K1K2_256, 0b0001'0001);
+			const __m512i MulHi2
+				= _mm512_clmulepi64_epi128(CRCVec2, K1K2_256, 0b0001'0001);
+			const __m512i MulHi3
+				= _mm512_clmulepi64_epi128(CRCVec3, K1K2_256, 0b0001'0001);
+
+			CRCVec0 = _mm512_ternarylogic_epi64(
+				MulHi0, MulLo0, _mm512_loadu_si512(Data.data() + 0),
+				TERNLOG_XOR3);
+			CRCVec1 = _mm512_ternarylogic_epi64(
+				MulHi1, MulLo1, _mm512_loadu_si512(Data.data() + 64),
+				TERNLOG_XOR3);
+			CRCVec2 = _mm512_ternarylogic_epi64(
+				MulHi2, MulLo2, _mm512_loadu_si512(Data.data() + 128),
+				TERNLOG_XOR3);
+			CRCVec3 = _mm512_ternarylogic_epi64(
+				MulHi3, MulLo3, _mm512_loadu_si512(Data.data() + 192),
+				TERNLOG_XOR3);
+		}
+
+		// Tree-reduce the four accumulators, folding Vec0 and Vec1 across 128
+		// bytes into Vec2 and Vec3, and then Vec2 across 64 bytes into Vec3
+		const __m512i K1K2_128 = _mm512_set_epi64(
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial),
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial),
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial),
+			KnConstantHi(128, Polynomial), KnConstantLo(128, Polynomial));
+
+		CRCVec2 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec0, K1K2_128, 0b0000'0000), CRCVec2,
+			TERNLOG_XOR3);
+		CRCVec3 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec1, K1K2_128, 0b0000'0000), CRCVec3,
+			TERNLOG_XOR3);
+
+		const __m512i K1K2_64 = _mm512_set_epi64(
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+			KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial));
+
+		CRCVec_512 = _mm512_ternarylogic_epi64(
+			_mm512_clmulepi64_epi128(CRCVec2, K1K2_64, 0b0001'0001),
+			_mm512_clmulepi64_epi128(CRCVec2, K1K2_64, 0b0000'0000), CRCVec3,
+			TERNLOG_XOR3);
+	}
+
+	// Fold 512 bits at a time
+	const __m512i K1K2 = _mm512_set_epi64(
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial),
+		KnConstantHi(64, Polynomial), KnConstantLo(64, Polynomial));
+
+	for( ; Data.size() >= 64; Data = Data.subspan(64) )
+	{
+		const __m512i MulLo
+			= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0000'0000);
+
+		const __m512i MulHi
+			= _mm512_clmulepi64_epi128(CRCVec_512, K1K2, 0b0001'0001);
+
+		const __m512i Load = _mm512_loadu_si512(Data.data());
+
+		CRCVec_512
+			= _mm512_ternarylogic_epi64(MulHi, MulLo, Load, TERNLOG_XOR3);
+	}
+
+	CRCVec0_128 = _mm512_extracti32x4_epi32(CRCVec_512, 0);
+	CRCVec1_128 = _mm512_extracti32x4_epi32(CRCVec_512, 1);
+	CRCVec2_128 = _mm512_extracti32x4_epi32(CRCVec_512, 2);
+	CRCVec3_128 = _mm512_extracti32x4_epi32(CRCVec_512, 3);
+
+	return Data;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+template<std::uint64_t Polynomial>
+TARGET_VPCLMULQDQ std::uint64_t
+	CRC64_VPCLMULQDQ(std::span<const std::byte> Data, std::uint64_t CRC)
+{
+	if( Data.size() < 64 )
+	{
+		return CRC64_PCLMULQDQ<Polynomial>(Data, CRC);
+	}
+
+	__m128i CRCVec0
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[0]);
+	__m128i CRCVec1
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[1]);
+	__m128i CRCVec2
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[2]);
+	__m128i CRCVec3
+		= _mm_loadu_si128(&reinterpret_cast<const __m128i*>(Data.data())[3]);
+
+	CRCVec0 = _mm_xor_si128(CRCVec0, _mm_cvtsi64_si128(CRC));
+
+	Data = CRC64_VPCLMULQDQ_Fold<Polynomial>(
+		Data.subspan(64), CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+
+	return CRC64_PCLMULQDQ_Reduce<Polynomial>(
+		Data, CRCVec0, CRCVec1, CRCVec2, CRCVec3);
+}
+
+using CRC64KernelT
+	= std::uint64_t (*)(std::span<const std::byte> Data, std::uint64_t CRC);
+
+// Each polynomial gets its own instantiation of the folding kernels, with all
+// of its folding and Barrett-reduction constants resolved at compile time.
+// Every kernel needs at least 16 bytes of input.
+static CRC64KernelT GetCRC64_PCLMULQDQ(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64_PCLMULQDQ<std::uint64_t(Polynomial64::ECMA182)>;
+	case Polynomial64::NVMe:
+		return CRC64_PCLMULQDQ<std::uint64_t(Polynomial64::NVMe)>;
+	}
+}
+
+static CRC64KernelT GetCRC64_VPCLMULQDQ_256(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64_VPCLMULQDQ_256<std::uint64_t(Polynomial64::ECMA182)>;
+	case Polynomial64::NVMe:
+		return CRC64_VPCLMULQDQ_256<std::uint64_t(Polynomial64::NVMe)>;
+	}
+}
+
+static CRC64KernelT GetCRC64_VPCLMULQDQ(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return CRC64_VPCLMULQDQ<std::uint64_t(Polynomial64::ECMA182)>;
+	case Polynomial64::NVMe:
+		return CRC64_VPCLMULQDQ<std::uint64_t(Polynomial64::NVMe)>;
+	}
+}
+
+// Slice by 8
+static std::span<const std::byte> CRC64_Slice8(
+	std::span<const std::byte> Data, std::uint64_t& CRC,
+	const CRC64TableT& Table)
+{
+	for( ; Data.size() >= 8; Data = Data.subspan(8) )
+	{
+		const std::uint64_t Input
+			= *reinterpret_cast<const std::uint64_t*>(Data.data()) ^ CRC;
+
+		CRC = Table[7][std::uint8_t(Input)]
+			^ Table[6][std::uint8_t(Input >> 8)]
+			^ Table[5][std::uint8_t(Input >> 16)]
+			^ Table[4][std::uint8_t(Input >> 24)]
+			^ Table[3][std::uint8_t(Input >> 32)]
+			^ Table[2][std::uint8_t(Input >> 40)]
+			^ Table[1][std::uint8_t(Input >> 48)]
+			^ Table[0][std::uint8_t(Input >> 56)];
+	}
+	return Data;
+}
+
+static std::uint64_t CRC64_Slice1(
+	std::span<const std::byte> Data, std::uint64_t CRC,
+	const CRC64TableT& Table)
+{
+	for( const std::byte& CurByte : Data )
+	{
+		CRC = (CRC >> 8) ^ Table[0][std::uint8_t(CRC) ^ std::uint8_t(CurByte)];
+	}
+	return CRC;
+}
+
+// Checksum implementations, from the most portable to the most specialized.
+// These operate upon the CRC register directly, without any bit-inversion.
+using Checksum64T = std::uint64_t (*)(
+	std::span<const std::byte> Data, std::uint64_t CRC, Polynomial64 Poly);
+
+static std::uint64_t Checksum64_Table(
+	std::span<const std::byte> Data, std::uint64_t CRC, Polynomial64 Poly)
+{
+	const auto& Table = GetCRC64Table(Poly);
+
+	Data = CRC64_Slice8(Data, CRC, Table);
+	return CRC64_Slice1(Data, CRC, Table);
+}
+
+TARGET_PCLMULQDQ static std::uint64_t Checksum64_PCLMULQDQ(
+	std::span<const std::byte> Data, std::uint64_t CRC, Polynomial64 Poly)
+{
+	if( Data.size() < 16 )
+	{
+		return Checksum64_Table(Data, CRC, Poly);
+	}
+
+	return GetCRC64_PCLMULQDQ(Poly)(Data, CRC);
+}
+
+TARGET_VPCLMULQDQ_256 static std::uint64_t Checksum64_VPCLMULQDQ_256(
+	std::span<const std::byte> Data, std::uint64_t CRC, Polynomial64 Poly)
+{
+	if( Data.size() < 16 )
+	{
+		return Checksum64_Table(Data, CRC, Poly);
+	}
+
+	return GetCRC64_VPCLMULQDQ_256(Poly)(Data, CRC);
+}
+
+TARGET_VPCLMULQDQ static std::uint64_t Checksum64_VPCLMULQDQ(
+	std::span<const std::byte> Data, std::uint64_t CRC, Polynomial64 Poly)
+{
+	if( Data.size() < 16 )
+	{
+		return Checksum64_Table(Data, CRC, Poly);
+	}
+
+	return GetCRC64_VPCLMULQDQ(Poly)(Data, CRC);
+}
+
+static Checksum64T SelectChecksum64()
+{
+	__builtin_cpu_init();
+
+	const bool HasAVX2   = __builtin_cpu_supports("avx2");
+	const bool HasAVX512 = __builtin_cpu_supports("avx512f")
+						&& __builtin_cpu_supports("avx512bw")
+						&& __builtin_cpu_supports("avx512dq")
+						&& __builtin_cpu_supports("avx512vl");
+	const bool HasPCLMULQDQ
+		= __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul");
+	const bool HasVPCLMULQDQ = __builtin_cpu_supports("vpclmulqdq");
+
+	if( HasAVX512 && HasPCLMULQDQ && HasVPCLMULQDQ )
+	{
+		return Checksum64_VPCLMULQDQ;
+	}
+	else if( HasAVX2 && HasPCLMULQDQ && HasVPCLMULQDQ )
+	{
+		return Checksum64_VPCLMULQDQ_256;
+	}
+	else if( HasPCLMULQDQ )
+	{
+		return Checksum64_PCLMULQDQ;
+	}
+	return Checksum64_Table;
+}
+
+std::uint64_t Checksum64(
+	std::span<const std::byte> Data, std::uint64_t InitialValue,
+	Polynomial64 Poly)
+{
+	// Resolved once, upon first use
+	static const Checksum64T Checksum64Impl = SelectChecksum64();
+	return ~Checksum64Impl(Data, ~InitialValue, Poly);
+}
+
+} // namespace CRC
+
+#endif
@@ -0,0 +1,77 @@
+#include <CRC64.hpp>
+
+#include <array>
+
+namespace CRC
+{
+
+// Multiplies two bit-reflected polynomials modulo P(x)
+static constexpr std::uint64_t
+	MultiplyModP(std::uint64_t A, std::uint64_t B, std::uint64_t Polynomial)
+{
+	std::uint64_t Product = 0;
+	for( std::uint64_t Mask = 1ull << 63; Mask; Mask >>= 1 )
+	{
+		if( A & Mask )
+		{
+			Product ^= B;
+		}
+		B = (B >> 1) ^ (-(B & 0b1) & Polynomial); // b *= x
+	}
+	return Product;
+}
+
+// x^(8 * 2^n) mod P(x) for each bit of a 64-bit byte count
+using XPowTableT = std::array<std::uint64_t, 64>;
+
+constexpr XPowTableT XPowTable(std::uint64_t Polynomial) noexcept
+{
+	XPowTableT Table = {};
+	Table[0]         = (1ull << 63) >> 8; // x^8
+	for( std::size_t i = 1; i < Table.size(); ++i )
+	{
+		Table[i] = MultiplyModP(Table[i - 1], Table[i - 1], Polynomial);
+	}
+	return Table;
+}
+
+template<Polynomial64 Poly>
+struct XPowTableStatic
+{
+	const XPowTableT& operator()() const
+	{
+		static constexpr XPowTableT Table = XPowTable(std::uint64_t(Poly));
+		return Table;
+	}
+};
+
+static const XPowTableT& GetXPowTable(Polynomial64 Poly)
+{
+	switch( Poly )
+	{
+	default:
+	case Polynomial64::ECMA182:
+		return XPowTableStatic<Polynomial64::ECMA182>()();
+	case Polynomial64::NVMe:
+		return XPowTableStatic<Polynomial64::NVMe>()();
+	}
+}
+
+std::uint64_t Combine64(
+	std::uint64_t CRCA, std::uint64_t CRCB, std::uint64_t LengthB,
+	Polynomial64 Poly)
+{
+	// Multiply CRCA by x^(8 * LengthB) mod P(x), one multiply for each set bit
+	// of LengthB. The pre and post-inversion of each CRC cancel out.
+	const auto& Table = GetXPowTable(Poly);
+	for( std::size_t i = 0; LengthB; LengthB >>= 1, ++i )
+	{
+		if( LengthB & 0b1 )
+		{
+			CRCA = MultiplyModP(CRCA, Table[i], std::uint64_t(Poly));
+		}
+	}
+	return CRCA ^ CRCB;
+}
+
+} // namespace CRC
@@ -0,0 +1,370 @@
+#include <IOUring.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// The ring's head and tail indices are shared with the kernel, which reads
+// them, and writes them, concurrently
+static std::uint32_t LoadAcquire(std::uint32_t* Index)
+{
+	return std::atomic_ref<std::uint32_t>(*Index).load(
+		std::memory_order_acquire);
+}
+
+static void StoreRelease(std::uint32_t* Index, std::uint32_t Value)
+{
+	std::atomic_ref<std::uint32_t>(*Index).store(
+		Value, std::memory_order_release);
+}
+
+template<typename T>
+static T* RingPointer(void* Ring, std::uint32_t Offset)
+{
+	return reinterpret_cast<T*>(static_cast<std::byte*>(Ring) + Offset);
+}
+
+// Whether the kernel supports each of the operations that are used. Kernels
+// before 5.6 have io_uring without IORING_OP_READ.
+static bool ProbeOperations(int RingHandle)
+{
+	constexpr std::size_t OperationCount = 256;
+
+	std::vector<std::byte> ProbeBuffer(
+		sizeof(io_uring_probe) + OperationCount * sizeof(io_uring_probe_op));
+	io_uring_probe* const Probe
+		= reinterpret_cast<io_uring_probe*>(ProbeBuffer.data());
+
+	if( syscall(
+			__NR_io_uring_register, RingHandle, IORING_REGISTER_PROBE, Probe,
+			OperationCount)
+		< 0 )
+	{
+		return false;
+	}
+
+	for( const unsigned CurOperation : {IORING_OP_READ, IORING_OP_READ_FIXED} )
+	{
+		if( CurOperation > Probe->last_op
+			|| !(Probe->ops[CurOperation].flags & IO_URING_OP_SUPPORTED) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::unique_ptr<IOUring> IOUring::Create(unsigned QueueDepth)
+{
+	io_uring_params Params = {};
+
+	const long RingHandle = syscall(__NR_io_uring_setup, QueueDepth, &Params);
+	if( RingHandle < 0 )
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<IOUring> Ring(new IOUring());
+	Ring->RingHandle = int(RingHandle);
+
+	if( !ProbeOperations(Ring->RingHandle) )
+	{
+		return nullptr;
+	}
+
+	Ring->SQRingSize
+		= Params.sq_off.array + Params.sq_entries * sizeof(std::uint32_t);
+	Ring->CQRingSize
+		= Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+
+	// Newer kernels map both rings at once
+	const bool SingleMap = Params.features & IORING_FEAT_SINGLE_MMAP;
+	if( SingleMap )
+	{
+		Ring->SQRingSize = std::max(Ring->SQRingSize, Ring->CQRingSize);
+	}
+
+	Ring->SQRing = mmap(
+		nullptr, Ring->SQRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, Ring->RingHandle, IORING_OFF_SQ_RING);
+	if( Ring->SQRing == MAP_FAILED )
+	{
+		Ring->SQRing = nullptr;
+		return nullptr;
+	}
+
+	if( SingleMap )
+	{
+		Ring->CQRing     = Ring->SQRing;
+		Ring->CQRingSize = 0;
+	}
+	else
+	{
+		Ring->CQRing = mmap(
+			nullptr, Ring->CQRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, Ring->RingHandle, IORING_OFF_CQ_RING);
+		if( Ring->CQRing == MAP_FAILED )
+		{
+			Ring->CQRing = nullptr;
+			return nullptr;
+		}
+	}
+
+	Ring->SQEntrySize = Params.sq_entries * sizeof(io_uring_sqe);
+
+	Ring->SQEntries = mmap(
+		nullptr, Ring->SQEntrySize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, Ring->RingHandle, IORING_OFF_SQES);
+	if( Ring->SQEntries == MAP_FAILED )
+	{
+		Ring->SQEntries = nullptr;
+		return nullptr;
+	}
+
+	const io_sqring_offsets& SQOffsets = Params.sq_off;
+	Ring->SQHead  = RingPointer<std::uint32_t>(Ring->SQRing, SQOffsets.head);
+	Ring->SQTail  = RingPointer<std::uint32_t>(Ring->SQRing, SQOffsets.tail);
+	Ring->SQArray = RingPointer<std::uint32_t>(Ring->SQRing, SQOffsets.array);
+	Ring->SQMask
+		= *RingPointer<std::uint32_t>(Ring->SQRing, SQOffsets.ring_mask);
+	Ring->SQCount = Params.sq_entries;
+
+	const io_cqring_offsets& CQOffsets = Params.cq_off;
+	Ring->CQHead    = RingPointer<std::uint32_t>(Ring->CQRing, CQOffsets.head);
+	Ring->CQTail    = RingPointer<std::uint32_t>(Ring->CQRing, CQOffsets.tail);
+	Ring->CQEntries = RingPointer<void>(Ring->CQRing, CQOffsets.cqes);
+	Ring->CQMask
+		= *RingPointer<std::uint32_t>(Ring->CQRing, CQOffsets.ring_mask);
+
+	return Ring;
+}
+
+IOUring::~IOUring()
+{
+	if( SQEntries )
+	{
+		munmap(SQEntries, SQEntrySize);
+	}
+	if( CQRing && CQRing != SQRing )
+	{
+		munmap(CQRing, CQRingSize);
+	}
+	if( SQRing )
+	{
+		munmap(SQRing, SQRingSize);
+	}
+	if( RingHandle >= 0 )
+	{
+		close(RingHandle);
+	}
+}
+
+bool IOUring::RegisterBuffers(std::span<const std::span<std::byte>> Buffers)
+{
+	std::vector<iovec> Vectors;
+	for( const std::span<std::byte> CurBuffer : Buffers )
+	{
+		Vectors.push_back(iovec{CurBuffer.data(), CurBuffer.size()});
+	}
+
+	// Fails upon exceeding RLIMIT_MEMLOCK, with older kernels
+	const long Result = syscall(
+		__NR_io_uring_register, RingHandle, IORING_REGISTER_BUFFERS,
+		Vectors.data(), unsigned(Vectors.size()));
+
+	BuffersRegistered = Result == 0;
+	return BuffersRegistered;
+}
+
+bool IOUring::QueueRead(
+	int FileHandle, std::span<std::byte> Data, std::uint64_t Offset,
+	std::uint64_t UserData, std::optional<unsigned> BufferIndex)
+{
+	const std::uint32_t Tail = *SQTail;
+	if( Tail - LoadAcquire(SQHead) >= SQCount )
+	{
+		return false;
+	}
+
+	io_uring_sqe& Entry = static_cast<io_uring_sqe*>(SQEntries)[Tail & SQMask];
+	std::memset(&Entry, 0, sizeof(Entry));
+	Entry.fd        = FileHandle;
+	Entry.off       = Offset;
+	Entry.addr      = std::uint64_t(std::uintptr_t(Data.data()));
+	Entry.len       = std::uint32_t(Data.size());
+	Entry.user_data = UserData;
+	if( BufferIndex.has_value() && BuffersRegistered )
+	{
+		Entry.opcode    = IORING_OP_READ_FIXED;
+		Entry.buf_index = std::uint16_t(*BufferIndex);
+	}
+	else
+	{
+		Entry.opcode = IORING_OP_READ;
+	}
+
+	SQArray[Tail & SQMask] = Tail & SQMask;
+	StoreRelease(SQTail, Tail + 1);
+	++Unsubmitted;
+	return true;
+}
+
+bool IOUring::Enter(unsigned MinComplete)
+{
+	while( true )
+	{
+		const long Result = syscall(
+			__NR_io_uring_enter, RingHandle, Unsubmitted, MinComplete,
+			MinComplete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+		if( Result >= 0 )
+		{
+			const std::uint32_t Submitted
+				= std::min<std::uint32_t>(Unsubmitted, Result);
+			Unsubmitted -= Submitted;
+			InFlight += Submitted;
+			if( !Unsubmitted || MinComplete )
+			{
+				return true;
+			}
+			continue;
+		}
+		if( errno == EINTR )
+		{
+			continue;
+		}
+		if( errno != EAGAIN && errno != EBUSY )
+		{
+			return false;
+		}
+
+		// The kernel has no room for more reads until some of those in flight
+		// complete, so the rest stay queued until then. Completions that have
+		// arrived already are left for the caller to reap first.
+		if( LoadAcquire(CQTail) != *CQHead )
+		{
+			return true;
+		}
+		if( !InFlight )
+		{
+			return false;
+		}
+		while( syscall(
+				   __NR_io_uring_enter, RingHandle, 0, 1,
+				   IORING_ENTER_GETEVENTS, nullptr, 0)
+			   < 0 )
+		{
+			if( errno != EINTR )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+bool IOUring::Submit()
+{
+	return !Unsubmitted || Enter(0);
+}
+
+std::optional<IOUring::Completion> IOUring::WaitCompletion()
+{
+	if( !Submit() )
+	{
+		return std::nullopt;
+	}
+
+	const std::uint32_t Head = *CQHead;
+	while( LoadAcquire(CQTail) == Head )
+	{
+		if( !Enter(1) )
+		{
+			return std::nullopt;
+		}
+	}
+
+	const io_uring_cqe& Entry
+		= static_cast<const io_uring_cqe*>(CQEntries)[Head & CQMask];
+	const Completion Result = {Entry.user_data, Entry.res};
+	StoreRelease(CQHead, Head + 1);
+	--InFlight;
+	return Result;
+}
+
+bool IOUring::Drain()
+{
+	// The kernel only takes reads from the submission queue within Enter, so
+	// those queued since can be taken back
+	StoreRelease(SQTail, *SQTail - Unsubmitted);
+	Unsubmitted = 0;
+
+	while( InFlight )
+	{
+		if( !WaitCompletion().has_value() )
+		{
+			Failed = true;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IOUring::IsFailed() const
+{
+	return Failed;
+}
+
+#else
+
+std::unique_ptr<IOUring> IOUring::Create(unsigned)
+{
+	return nullptr;
+}
+
+IOUring::~IOUring()
+{
+}
+
+bool IOUring::RegisterBuffers(std::span<const std::span<std::byte>>)
+{
+	return false;
+}
+
+bool IOUring::QueueRead(
+	int, std::span<std::byte>, std::uint64_t, std::uint64_t,
+	std::optional<unsigned>)
+{
+	return false;
+}
+
+bool IOUring::Submit()
+{
+	return false;
+}
+
+std::optional<IOUring::Completion> IOUring::WaitCompletion()
+{
+	return std::nullopt;
+}
+
+bool IOUring::Drain()
+{
+	return true;
+}
+
+bool IOUring::IsFailed() const
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace MD5
+{
+
+inline constexpr std::size_t BlockSize = 64;
+
+alignas(64) inline constexpr std::array<std::uint32_t, 64> RoundConstants = {
+	0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A,
+	0xA8304613, 0xFD469501, 0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE,
+	0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821, 0xF61E2562, 0xC040B340,
+	0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+	0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8,
+	0x676F02D9, 0x8D2A4C8A, 0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C,
+	0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70, 0x289B7EC6, 0xEAA127FA,
+	0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+	0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92,
+	0xFFEFF47D, 0x85845DD1, 0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1,
+	0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391,
+};
+
+// Rotation of each step, which only depends on the round and the step's
+// position within a group of four
+inline constexpr std::array<std::array<int, 4>, 4> RoundShifts = {{
+	{7, 12, 17, 22},
+	{5, 9, 14, 20},
+	{4, 11, 16, 23},
+	{6, 10, 15, 21},
+}};
+
+// Index of the message word that each step adds in
+constexpr std::size_t MessageIndex(std::size_t Step)
+{
+	switch( Step / 16 )
+	{
+	default:
+	case 0:
+		return Step;
+	case 1:
+		return (5 * Step + 1) % 16;
+	case 2:
+		return (3 * Step + 5) % 16;
+	case 3:
+		return (7 * Step) % 16;
+	}
+}
+
+inline constexpr std::array<std::uint32_t, 4> InitialState = {
+	0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
+};
+
+void Compress_Scalar(
+	std::span<std::uint32_t, 4> State, const std::byte* Input,
+	std::size_t BlockCount);
+
+// The states of several independent hashes, word-major, so that the same word
+// of each lane is contiguous and loads into a single vector register
+inline constexpr std::size_t MaxLanes = 16;
+using LaneStateT = std::array<std::array<std::uint32_t, MaxLanes>, 4>;
+
+// Stands in for the input of a lane with nothing left to hash
+alignas(64) inline constexpr std::array<std::byte, BlockSize> ZeroBlock = {};
+
+// Compresses BlockCount consecutive blocks of each lane's input into the
+// state of that lane. Lanes without an input compress the zero block, and
+// their states are left meaningless.
+using CompressLanesT = void (*)(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount);
+
+struct CompressLanesKernel
+{
+	CompressLanesT Compress  = nullptr;
+	std::size_t    LaneCount = 0;
+};
+
+// The widest multi-buffer kernel of the host, resolved once, upon first use.
+// Has no kernel at all upon hosts without one, where each input is hashed on
+// its own instead.
+CompressLanesKernel GetCompressLanes();
+
+} // namespace MD5
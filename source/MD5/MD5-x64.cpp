@@ -0,0 +1,299 @@
+#if defined(_M_X64) || defined(__amd64__)
+
+#include <MD5.hpp>
+
+#include "MD5-Compress.hpp"
+
+#include <utility>
+
+#include <immintrin.h>
+
+namespace MD5
+{
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx2,avx512f")))
+
+// The multi-buffer kernels hold one lane in each 32-bit element of a vector,
+// and run the steps of the scalar algorithm on all of them at once. Blocks are
+// loaded one lane to each register and then transposed, so that each register
+// holds the same message word of every lane. Each step is instantiated on its
+// own so that its round function, constant, and rotation are all immediates.
+// Rather than moving the working variables along after each step, each step
+// picks its A, B, C, and D out of Vars by its position within a group of four.
+
+template<std::size_t Step>
+TARGET_AVX2 static inline void Step_AVX2(__m256i* Vars, const __m256i* M)
+{
+	__m256i&      A = Vars[(4 - Step % 4) % 4];
+	const __m256i B = Vars[(5 - Step % 4) % 4];
+	const __m256i C = Vars[(6 - Step % 4) % 4];
+	const __m256i D = Vars[(7 - Step % 4) % 4];
+
+	__m256i F;
+	if constexpr( Step < 16 )
+	{
+		// B ? C : D
+		F = _mm256_xor_si256(D, _mm256_and_si256(B, _mm256_xor_si256(C, D)));
+	}
+	else if constexpr( Step < 32 )
+	{
+		// D ? B : C
+		F = _mm256_xor_si256(C, _mm256_and_si256(D, _mm256_xor_si256(B, C)));
+	}
+	else if constexpr( Step < 48 )
+	{
+		// B ^ C ^ D
+		F = _mm256_xor_si256(_mm256_xor_si256(B, C), D);
+	}
+	else
+	{
+		// C ^ (B | ~D)
+		const __m256i NotD = _mm256_xor_si256(D, _mm256_set1_epi32(-1));
+		F = _mm256_xor_si256(C, _mm256_or_si256(B, NotD));
+	}
+
+	F = _mm256_add_epi32(
+		_mm256_add_epi32(A, F),
+		_mm256_add_epi32(
+			_mm256_set1_epi32(RoundConstants[Step]), M[MessageIndex(Step)]));
+
+	constexpr int Shift = RoundShifts[Step / 16][Step % 4];
+
+	const __m256i Rotated = _mm256_or_si256(
+		_mm256_slli_epi32(F, Shift), _mm256_srli_epi32(F, 32 - Shift));
+	A = _mm256_add_epi32(B, Rotated);
+}
+
+template<std::size_t... Steps>
+TARGET_AVX2 static inline void
+	Steps_AVX2(__m256i* Vars, const __m256i* M, std::index_sequence<Steps...>)
+{
+	(Step_AVX2<Steps>(Vars, M), ...);
+}
+
+// Transposes eight rows of eight 32-bit elements
+TARGET_AVX2 static inline void Transpose8x8_AVX2(__m256i* Rows)
+{
+	__m256i Pairs[8];
+	for( std::size_t i = 0; i < 8; i += 2 )
+	{
+		Pairs[i + 0] = _mm256_unpacklo_epi32(Rows[i], Rows[i + 1]);
+		Pairs[i + 1] = _mm256_unpackhi_epi32(Rows[i], Rows[i + 1]);
+	}
+
+	// Quads[4 * q + c] holds element 4 * l + c of rows 4 * q to 4 * q + 3,
+	// within each 128-bit lane l
+	__m256i Quads[8];
+	for( std::size_t i = 0; i < 8; i += 4 )
+	{
+		Quads[i + 0] = _mm256_unpacklo_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 1] = _mm256_unpackhi_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 2] = _mm256_unpacklo_epi64(Pairs[i + 1], Pairs[i + 3]);
+		Quads[i + 3] = _mm256_unpackhi_epi64(Pairs[i + 1], Pairs[i + 3]);
+	}
+
+	for( std::size_t c = 0; c < 4; ++c )
+	{
+		Rows[c + 0] = _mm256_permute2x128_si256(Quads[c], Quads[c + 4], 0x20);
+		Rows[c + 4] = _mm256_permute2x128_si256(Quads[c], Quads[c + 4], 0x31);
+	}
+}
+
+TARGET_AVX2 static void CompressLanes_AVX2(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount)
+{
+	__m256i Vars[4];
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		Vars[i] = _mm256_load_si256(
+			reinterpret_cast<const __m256i*>(State[i].data()));
+	}
+
+	for( std::size_t j = 0; j < BlockCount; ++j )
+	{
+		__m256i M[16];
+		for( std::size_t i = 0; i < 8; ++i )
+		{
+			const __m256i* Block = reinterpret_cast<const __m256i*>(
+				Inputs[i] ? Inputs[i] + j * BlockSize : ZeroBlock.data());
+			M[i + 0] = _mm256_loadu_si256(Block + 0);
+			M[i + 8] = _mm256_loadu_si256(Block + 1);
+		}
+		Transpose8x8_AVX2(M + 0);
+		Transpose8x8_AVX2(M + 8);
+
+		__m256i Prev[4] = {Vars[0], Vars[1], Vars[2], Vars[3]};
+
+		Steps_AVX2(Vars, M, std::make_index_sequence<64>{});
+
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			Vars[i] = _mm256_add_epi32(Vars[i], Prev[i]);
+		}
+	}
+
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		_mm256_store_si256(
+			reinterpret_cast<__m256i*>(State[i].data()), Vars[i]);
+	}
+}
+
+// The unmasked AVX-512 intrinsics of GCC 12 merge into undefined vectors,
+// which it then warns about as uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+template<std::size_t Step>
+TARGET_AVX512 static inline void Step_AVX512(__m512i* Vars, const __m512i* M)
+{
+	__m512i&      A = Vars[(4 - Step % 4) % 4];
+	const __m512i B = Vars[(5 - Step % 4) % 4];
+	const __m512i C = Vars[(6 - Step % 4) % 4];
+	const __m512i D = Vars[(7 - Step % 4) % 4];
+
+	__m512i F;
+	if constexpr( Step < 16 )
+	{
+		// B ? C : D
+		F = _mm512_ternarylogic_epi32(B, C, D, 0xCA);
+	}
+	else if constexpr( Step < 32 )
+	{
+		// D ? B : C
+		F = _mm512_ternarylogic_epi32(B, C, D, 0xE4);
+	}
+	else if constexpr( Step < 48 )
+	{
+		// B ^ C ^ D
+		F = _mm512_ternarylogic_epi32(B, C, D, 0x96);
+	}
+	else
+	{
+		// C ^ (B | ~D)
+		F = _mm512_ternarylogic_epi32(B, C, D, 0x39);
+	}
+
+	F = _mm512_add_epi32(
+		_mm512_add_epi32(A, F),
+		_mm512_add_epi32(
+			_mm512_set1_epi32(RoundConstants[Step]), M[MessageIndex(Step)]));
+
+	A = _mm512_add_epi32(
+		B, _mm512_rol_epi32(F, RoundShifts[Step / 16][Step % 4]));
+}
+
+template<std::size_t... Steps>
+TARGET_AVX512 static inline void Steps_AVX512(
+	__m512i* Vars, const __m512i* M, std::index_sequence<Steps...>)
+{
+	(Step_AVX512<Steps>(Vars, M), ...);
+}
+
+// Transposes sixteen rows of sixteen 32-bit elements
+TARGET_AVX512 static inline void Transpose16x16_AVX512(__m512i* Rows)
+{
+	__m512i Pairs[16];
+	for( std::size_t i = 0; i < 16; i += 2 )
+	{
+		Pairs[i + 0] = _mm512_unpacklo_epi32(Rows[i], Rows[i + 1]);
+		Pairs[i + 1] = _mm512_unpackhi_epi32(Rows[i], Rows[i + 1]);
+	}
+
+	// Quads[4 * q + c] holds element 4 * l + c of rows 4 * q to 4 * q + 3,
+	// within each 128-bit lane l
+	__m512i Quads[16];
+	for( std::size_t i = 0; i < 16; i += 4 )
+	{
+		Quads[i + 0] = _mm512_unpacklo_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 1] = _mm512_unpackhi_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 2] = _mm512_unpacklo_epi64(Pairs[i + 1], Pairs[i + 3]);
+		Quads[i + 3] = _mm512_unpackhi_epi64(Pairs[i + 1], Pairs[i + 3]);
+	}
+
+	// What is left is to transpose the 128-bit lanes of each group of four
+	for( std::size_t c = 0; c < 4; ++c )
+	{
+		const __m512i Lo01
+			= _mm512_shuffle_i32x4(Quads[c + 0], Quads[c + 4], 0b01'00'01'00);
+		const __m512i Hi01
+			= _mm512_shuffle_i32x4(Quads[c + 0], Quads[c + 4], 0b11'10'11'10);
+		const __m512i Lo23
+			= _mm512_shuffle_i32x4(Quads[c + 8], Quads[c + 12], 0b01'00'01'00);
+		const __m512i Hi23
+			= _mm512_shuffle_i32x4(Quads[c + 8], Quads[c + 12], 0b11'10'11'10);
+
+		Rows[c + 0]  = _mm512_shuffle_i32x4(Lo01, Lo23, 0b10'00'10'00);
+		Rows[c + 4]  = _mm512_shuffle_i32x4(Lo01, Lo23, 0b11'01'11'01);
+		Rows[c + 8]  = _mm512_shuffle_i32x4(Hi01, Hi23, 0b10'00'10'00);
+		Rows[c + 12] = _mm512_shuffle_i32x4(Hi01, Hi23, 0b11'01'11'01);
+	}
+}
+
+TARGET_AVX512 static void CompressLanes_AVX512(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount)
+{
+	__m512i Vars[4];
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		Vars[i] = _mm512_load_si512(State[i].data());
+	}
+
+	for( std::size_t j = 0; j < BlockCount; ++j )
+	{
+		__m512i M[16];
+		for( std::size_t i = 0; i < 16; ++i )
+		{
+			M[i] = _mm512_loadu_si512(
+				Inputs[i] ? Inputs[i] + j * BlockSize : ZeroBlock.data());
+		}
+		Transpose16x16_AVX512(M);
+
+		__m512i Prev[4] = {Vars[0], Vars[1], Vars[2], Vars[3]};
+
+		Steps_AVX512(Vars, M, std::make_index_sequence<64>{});
+
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			Vars[i] = _mm512_add_epi32(Vars[i], Prev[i]);
+		}
+	}
+
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		_mm512_store_si512(State[i].data(), Vars[i]);
+	}
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static CompressLanesKernel SelectCompressLanes()
+{
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("avx512f") )
+	{
+		return {CompressLanes_AVX512, 16};
+	}
+	else if( __builtin_cpu_supports("avx2") )
+	{
+		return {CompressLanes_AVX2, 8};
+	}
+	return {};
+}
+
+CompressLanesKernel GetCompressLanes()
+{
+	static const CompressLanesKernel CompressLanesImpl = SelectCompressLanes();
+	return CompressLanesImpl;
+}
+
+} // namespace MD5
+
+#endif
@@ -0,0 +1,333 @@
+#include <MD5.hpp>
+
+#include "MD5-Compress.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace MD5
+{
+
+static std::uint32_t ReadLittleEndian32(const std::byte* Data)
+{
+	std::uint32_t Value;
+	std::memcpy(&Value, Data, sizeof(Value));
+	if constexpr( std::endian::native == std::endian::big )
+	{
+		Value = __builtin_bswap32(Value);
+	}
+	return Value;
+}
+
+// Each step is instantiated on its own so that its round function, constant,
+// and rotation are all known at compile time
+template<std::size_t Step>
+static inline void Step_Scalar(std::uint32_t* Vars, const std::uint32_t* M)
+{
+	std::uint32_t&      A = Vars[(4 - Step % 4) % 4];
+	const std::uint32_t B = Vars[(5 - Step % 4) % 4];
+	const std::uint32_t C = Vars[(6 - Step % 4) % 4];
+	const std::uint32_t D = Vars[(7 - Step % 4) % 4];
+
+	std::uint32_t F;
+	if constexpr( Step < 16 )
+	{
+		F = D ^ (B & (C ^ D));
+	}
+	else if constexpr( Step < 32 )
+	{
+		F = C ^ (D & (B ^ C));
+	}
+	else if constexpr( Step < 48 )
+	{
+		F = B ^ C ^ D;
+	}
+	else
+	{
+		F = C ^ (B | ~D);
+	}
+
+	F += A + RoundConstants[Step] + M[MessageIndex(Step)];
+	A = B + std::rotl(F, RoundShifts[Step / 16][Step % 4]);
+}
+
+template<std::size_t... Steps>
+static inline void Steps_Scalar(
+	std::uint32_t* Vars, const std::uint32_t* M, std::index_sequence<Steps...>)
+{
+	(Step_Scalar<Steps>(Vars, M), ...);
+}
+
+void Compress_Scalar(
+	std::span<std::uint32_t, 4> State, const std::byte* Input,
+	std::size_t BlockCount)
+{
+	for( std::size_t i = 0; i < BlockCount; ++i, Input += BlockSize )
+	{
+		std::array<std::uint32_t, 16> M;
+		for( std::size_t j = 0; j < M.size(); ++j )
+		{
+			M[j] = ReadLittleEndian32(Input + j * 4);
+		}
+
+		std::uint32_t Vars[4] = {State[0], State[1], State[2], State[3]};
+
+		Steps_Scalar(Vars, M.data(), std::make_index_sequence<64>{});
+
+		for( std::size_t j = 0; j < 4; ++j )
+		{
+			State[j] += Vars[j];
+		}
+	}
+}
+
+#if !defined(_M_X64) && !defined(__amd64__)
+CompressLanesKernel GetCompressLanes()
+{
+	return {};
+}
+#endif
+
+static Digest128 ToDigest(std::span<const std::uint32_t, 4> State)
+{
+	Digest128 Result;
+	for( std::size_t i = 0; i < State.size(); ++i )
+	{
+		Result[i * 4 + 0] = std::uint8_t(State[i] >> 0);
+		Result[i * 4 + 1] = std::uint8_t(State[i] >> 8);
+		Result[i * 4 + 2] = std::uint8_t(State[i] >> 16);
+		Result[i * 4 + 3] = std::uint8_t(State[i] >> 24);
+	}
+	return Result;
+}
+
+// Pads the last, partial, block of an input of Length bytes into Tail and
+// returns how many blocks it now takes up
+static std::size_t PadTail(
+	std::span<const std::byte> Remainder, std::uint64_t Length,
+	std::span<std::byte, BlockSize * 2> Tail)
+{
+	const std::size_t TailBlocks
+		= Remainder.size() + 1 + sizeof(Length) > BlockSize ? 2 : 1;
+
+	std::fill(Tail.begin(), Tail.end(), std::byte{0});
+	std::copy(Remainder.begin(), Remainder.end(), Tail.begin());
+	Tail[Remainder.size()] = std::byte{0x80};
+
+	const std::uint64_t BitLength = Length * 8;
+	for( std::size_t i = 0; i < sizeof(BitLength); ++i )
+	{
+		Tail[TailBlocks * BlockSize - sizeof(BitLength) + i]
+			= std::byte(BitLength >> (i * 8));
+	}
+	return TailBlocks;
+}
+
+Digest128 Hash(std::span<const std::byte> Data)
+{
+	Hasher CurHasher;
+	CurHasher.Update(Data);
+	return CurHasher.Finalize();
+}
+
+// Reads the state of one lane back out of the states of all of them
+static std::array<std::uint32_t, 4>
+	LaneState(const LaneStateT& State, std::size_t LaneIndex)
+{
+	std::array<std::uint32_t, 4> Result;
+	for( std::size_t i = 0; i < Result.size(); ++i )
+	{
+		Result[i] = State[i][LaneIndex];
+	}
+	return Result;
+}
+
+// The input being hashed within one lane. Its whole blocks are compressed
+// straight from the input, and then its padded tail.
+struct LaneInput
+{
+	std::size_t InputIndex;
+	std::size_t BlocksLeft;
+	bool        InTail;
+
+	alignas(64) std::array<std::byte, BlockSize * 2> Tail;
+	std::size_t TailBlocks;
+};
+
+void Hash(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<Digest128>                         Digests)
+{
+	const CompressLanesKernel Kernel = GetCompressLanes();
+	if( !Kernel.Compress )
+	{
+		for( std::size_t i = 0; i < Inputs.size(); ++i )
+		{
+			Digests[i] = Hash(Inputs[i]);
+		}
+		return;
+	}
+
+	alignas(64) LaneStateT State;
+	std::array<LaneInput, MaxLanes>        Lanes;
+	std::array<const std::byte*, MaxLanes> LaneBlocks = {};
+	std::size_t                            NextInput  = 0;
+
+	// Starts the next input within a lane, or leaves the lane idle once there
+	// are none left
+	const auto BeginLane = [&](std::size_t LaneIndex) {
+		LaneInput& CurLane = Lanes[LaneIndex];
+		if( NextInput == Inputs.size() )
+		{
+			LaneBlocks[LaneIndex] = nullptr;
+			return;
+		}
+
+		const std::span<const std::byte> Input = Inputs[NextInput];
+		const std::size_t WholeBlocks          = Input.size() / BlockSize;
+
+		CurLane.InputIndex = NextInput++;
+		CurLane.TailBlocks = PadTail(
+			Input.subspan(WholeBlocks * BlockSize), Input.size(),
+			CurLane.Tail);
+		CurLane.InTail = WholeBlocks == 0;
+		CurLane.BlocksLeft
+			= CurLane.InTail ? CurLane.TailBlocks : WholeBlocks;
+		LaneBlocks[LaneIndex]
+			= CurLane.InTail ? CurLane.Tail.data() : Input.data();
+
+		for( std::size_t i = 0; i < InitialState.size(); ++i )
+		{
+			State[i][LaneIndex] = InitialState[i];
+		}
+	};
+
+	for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+	{
+		BeginLane(i);
+	}
+
+	while( true )
+	{
+		std::size_t BlockCount  = std::numeric_limits<std::size_t>::max();
+		std::size_t ActiveLanes = 0;
+		std::size_t LastLane    = 0;
+		for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+		{
+			if( LaneBlocks[i] )
+			{
+				BlockCount = std::min(BlockCount, Lanes[i].BlocksLeft);
+				++ActiveLanes;
+				LastLane = i;
+			}
+		}
+
+		if( ActiveLanes == 0 )
+		{
+			return;
+		}
+
+		// Lanes are only ever left idle once every input has begun, so the
+		// last input is finished on its own rather than in one lane of many
+		if( ActiveLanes == 1 )
+		{
+			const LaneInput& CurLane = Lanes[LastLane];
+
+			std::array<std::uint32_t, 4> LastState
+				= LaneState(State, LastLane);
+
+			Compress_Scalar(
+				LastState, LaneBlocks[LastLane], CurLane.BlocksLeft);
+			if( !CurLane.InTail )
+			{
+				Compress_Scalar(
+					LastState, CurLane.Tail.data(), CurLane.TailBlocks);
+			}
+
+			Digests[CurLane.InputIndex] = ToDigest(LastState);
+			return;
+		}
+
+		Kernel.Compress(State, LaneBlocks, BlockCount);
+
+		for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+		{
+			LaneInput& CurLane = Lanes[i];
+			if( !LaneBlocks[i] )
+			{
+				continue;
+			}
+
+			LaneBlocks[i] += BlockCount * BlockSize;
+			CurLane.BlocksLeft -= BlockCount;
+			if( CurLane.BlocksLeft )
+			{
+				continue;
+			}
+
+			if( !CurLane.InTail )
+			{
+				CurLane.InTail     = true;
+				CurLane.BlocksLeft = CurLane.TailBlocks;
+				LaneBlocks[i]      = CurLane.Tail.data();
+				continue;
+			}
+
+			Digests[CurLane.InputIndex] = ToDigest(LaneState(State, i));
+
+			BeginLane(i);
+		}
+	}
+}
+
+Hasher::Hasher() : State(InitialState)
+{
+}
+
+void Hasher::Update(std::span<const std::byte> Data)
+{
+	TotalLength += Data.size();
+
+	if( BufferSize + Data.size() < Buffer.size() )
+	{
+		std::copy(Data.begin(), Data.end(), Buffer.begin() + BufferSize);
+		BufferSize += Data.size();
+		return;
+	}
+
+	// Top off the buffer and compress all of it
+	if( BufferSize )
+	{
+		const std::size_t LoadSize = Buffer.size() - BufferSize;
+		std::copy_n(Data.begin(), LoadSize, Buffer.begin() + BufferSize);
+		Data = Data.subspan(LoadSize);
+
+		Compress_Scalar(State, Buffer.data(), 1);
+		BufferSize = 0;
+	}
+
+	// Compress whole blocks directly from the input
+	const std::size_t BlockCount = Data.size() / BlockSize;
+	Compress_Scalar(State, Data.data(), BlockCount);
+	Data = Data.subspan(BlockCount * BlockSize);
+
+	std::copy(Data.begin(), Data.end(), Buffer.begin());
+	BufferSize = Data.size();
+}
+
+Digest128 Hasher::Finalize() const
+{
+	std::array<std::uint32_t, 4> FinalState = State;
+
+	alignas(64) std::array<std::byte, BlockSize * 2> Tail;
+	const std::size_t                                TailBlocks
+		= PadTail(std::span(Buffer).first(BufferSize), TotalLength, Tail);
+	Compress_Scalar(FinalState, Tail.data(), TailBlocks);
+
+	return ToDigest(FinalState);
+}
+
+} // namespace MD5
@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace SHA
+{
+
+inline constexpr std::size_t BlockSize = 64;
+
+alignas(64) inline constexpr std::array<std::uint32_t, 64> RoundConstants = {
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+	0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+	0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+	0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+	0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+	0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+	0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+	0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+	0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+inline constexpr std::array<std::uint32_t, 8> InitialState = {
+	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+	0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+// Compresses BlockCount consecutive blocks of Input into State
+using CompressT = void (*)(
+	std::span<std::uint32_t, 8> State, const std::byte* Input,
+	std::size_t BlockCount);
+
+void Compress_Scalar(
+	std::span<std::uint32_t, 8> State, const std::byte* Input,
+	std::size_t BlockCount);
+
+// The fastest single-buffer kernel of the host, resolved once, upon first use
+CompressT GetCompress();
+
+// The states of several independent hashes, word-major, so that the same word
+// of each lane is contiguous and loads into a single vector register
+inline constexpr std::size_t MaxLanes = 16;
+using LaneStateT = std::array<std::array<std::uint32_t, MaxLanes>, 8>;
+
+// Stands in for the input of a lane with nothing left to hash
+alignas(64) inline constexpr std::array<std::byte, BlockSize> ZeroBlock = {};
+
+// Compresses BlockCount consecutive blocks of each lane's input into the
+// state of that lane. Lanes without an input compress the zero block, and
+// their states are left meaningless.
+using CompressLanesT = void (*)(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount);
+
+struct CompressLanesKernel
+{
+	CompressLanesT Compress  = nullptr;
+	std::size_t    LaneCount = 0;
+};
+
+// The widest multi-buffer kernel of the host, resolved once, upon first use.
+// Has no kernel at all when hashing each input on its own would be as fast.
+CompressLanesKernel GetCompressLanes();
+
+} // namespace SHA
@@ -0,0 +1,99 @@
+#if defined(__aarch64__)
+
+#include <SHA256.hpp>
+
+#include "SHA256-Compress.hpp"
+
+#include <arm_neon.h>
+
+namespace SHA
+{
+
+#if defined(__ARM_FEATURE_SHA2)
+
+// Four rounds, of the four message words in Msg
+static inline void Rounds4_SHA2(
+	uint32x4_t& ABCD, uint32x4_t& EFGH, uint32x4_t Msg, std::size_t Round)
+{
+	const uint32x4_t WK = vaddq_u32(Msg, vld1q_u32(&RoundConstants[Round]));
+	const uint32x4_t PrevABCD = ABCD;
+
+	ABCD = vsha256hq_u32(ABCD, EFGH, WK);
+	EFGH = vsha256h2q_u32(EFGH, PrevABCD, WK);
+}
+
+// The next four message words, from the last sixteen
+static inline uint32x4_t
+	Schedule4_SHA2(uint32x4_t W16, uint32x4_t W12, uint32x4_t W8, uint32x4_t W4)
+{
+	return vsha256su1q_u32(vsha256su0q_u32(W16, W12), W8, W4);
+}
+
+static void Compress_SHA2(
+	std::span<std::uint32_t, 8> State, const std::byte* Input,
+	std::size_t BlockCount)
+{
+	uint32x4_t ABCD = vld1q_u32(State.data() + 0);
+	uint32x4_t EFGH = vld1q_u32(State.data() + 4);
+
+	for( std::size_t i = 0; i < BlockCount; ++i, Input += BlockSize )
+	{
+		const uint32x4_t SaveABCD = ABCD;
+		const uint32x4_t SaveEFGH = EFGH;
+
+		const std::uint8_t* Block
+			= reinterpret_cast<const std::uint8_t*>(Input);
+
+		uint32x4_t W0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Block + 0)));
+		uint32x4_t W1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Block + 16)));
+		uint32x4_t W2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Block + 32)));
+		uint32x4_t W3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Block + 48)));
+
+		Rounds4_SHA2(ABCD, EFGH, W0, 0);
+		Rounds4_SHA2(ABCD, EFGH, W1, 4);
+		Rounds4_SHA2(ABCD, EFGH, W2, 8);
+		Rounds4_SHA2(ABCD, EFGH, W3, 12);
+
+		for( std::size_t Round = 16; Round < 64; Round += 16 )
+		{
+			W0 = Schedule4_SHA2(W0, W1, W2, W3);
+			Rounds4_SHA2(ABCD, EFGH, W0, Round + 0);
+			W1 = Schedule4_SHA2(W1, W2, W3, W0);
+			Rounds4_SHA2(ABCD, EFGH, W1, Round + 4);
+			W2 = Schedule4_SHA2(W2, W3, W0, W1);
+			Rounds4_SHA2(ABCD, EFGH, W2, Round + 8);
+			W3 = Schedule4_SHA2(W3, W0, W1, W2);
+			Rounds4_SHA2(ABCD, EFGH, W3, Round + 12);
+		}
+
+		ABCD = vaddq_u32(ABCD, SaveABCD);
+		EFGH = vaddq_u32(EFGH, SaveEFGH);
+	}
+
+	vst1q_u32(State.data() + 0, ABCD);
+	vst1q_u32(State.data() + 4, EFGH);
+}
+
+CompressT GetCompress()
+{
+	return Compress_SHA2;
+}
+
+#else
+
+CompressT GetCompress()
+{
+	return Compress_Scalar;
+}
+
+#endif
+
+// The SHA-2 instructions already outpace four lanes of NEON
+CompressLanesKernel GetCompressLanes()
+{
+	return {};
+}
+
+} // namespace SHA
+
+#endif
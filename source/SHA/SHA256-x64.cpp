@@ -0,0 +1,444 @@
+#if defined(_M_X64) || defined(__amd64__)
+
+#include <SHA256.hpp>
+
+#include "SHA256-Compress.hpp"
+
+#include <immintrin.h>
+
+namespace SHA
+{
+
+#define TARGET_SHA __attribute__((target("sha,sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+
+// Four rounds, of the four message words in Msg
+TARGET_SHA static inline void Rounds4_SHA(
+	__m128i& State0, __m128i& State1, __m128i Msg, std::size_t Round)
+{
+	Msg = _mm_add_epi32(
+		Msg, _mm_load_si128(reinterpret_cast<const __m128i*>(
+				 RoundConstants.data() + Round)));
+	State1 = _mm_sha256rnds2_epu32(State1, State0, Msg);
+	State0 = _mm_sha256rnds2_epu32(
+		State0, State1, _mm_shuffle_epi32(Msg, 0b00'00'11'10));
+}
+
+// The next four message words, from the last sixteen
+TARGET_SHA static inline __m128i
+	Schedule4_SHA(__m128i W16, __m128i W12, __m128i W8, __m128i W4)
+{
+	return _mm_sha256msg2_epu32(
+		_mm_add_epi32(
+			_mm_sha256msg1_epu32(W16, W12), _mm_alignr_epi8(W4, W8, 4)),
+		W4);
+}
+
+// The SHA extensions keep the state as the two halves {A, B, E, F} and
+// {C, D, G, H}, in reverse order
+TARGET_SHA static void Compress_SHA(
+	std::span<std::uint32_t, 8> State, const std::byte* Input,
+	std::size_t BlockCount)
+{
+	const __m128i ByteSwap
+		= _mm_set_epi64x(0x0C0D0E0F08090A0Bull, 0x0405060700010203ull);
+
+	const __m128i DCBA
+		= _mm_loadu_si128(reinterpret_cast<const __m128i*>(State.data()));
+	const __m128i HGFE
+		= _mm_loadu_si128(reinterpret_cast<const __m128i*>(State.data() + 4));
+
+	const __m128i CDAB = _mm_shuffle_epi32(DCBA, 0b10'11'00'01);
+	const __m128i EFGH = _mm_shuffle_epi32(HGFE, 0b00'01'10'11);
+
+	__m128i State0 = _mm_alignr_epi8(CDAB, EFGH, 8);   // ABEF
+	__m128i State1 = _mm_blend_epi16(EFGH, CDAB, 0xF0); // CDGH
+
+	for( std::size_t i = 0; i < BlockCount; ++i, Input += BlockSize )
+	{
+		const __m128i Save0 = State0;
+		const __m128i Save1 = State1;
+
+		const __m128i* Block = reinterpret_cast<const __m128i*>(Input);
+
+		__m128i W0 = _mm_shuffle_epi8(_mm_loadu_si128(Block + 0), ByteSwap);
+		__m128i W1 = _mm_shuffle_epi8(_mm_loadu_si128(Block + 1), ByteSwap);
+		__m128i W2 = _mm_shuffle_epi8(_mm_loadu_si128(Block + 2), ByteSwap);
+		__m128i W3 = _mm_shuffle_epi8(_mm_loadu_si128(Block + 3), ByteSwap);
+
+		Rounds4_SHA(State0, State1, W0, 0);
+		Rounds4_SHA(State0, State1, W1, 4);
+		Rounds4_SHA(State0, State1, W2, 8);
+		Rounds4_SHA(State0, State1, W3, 12);
+
+		for( std::size_t Round = 16; Round < 64; Round += 16 )
+		{
+			W0 = Schedule4_SHA(W0, W1, W2, W3);
+			Rounds4_SHA(State0, State1, W0, Round + 0);
+			W1 = Schedule4_SHA(W1, W2, W3, W0);
+			Rounds4_SHA(State0, State1, W1, Round + 4);
+			W2 = Schedule4_SHA(W2, W3, W0, W1);
+			Rounds4_SHA(State0, State1, W2, Round + 8);
+			W3 = Schedule4_SHA(W3, W0, W1, W2);
+			Rounds4_SHA(State0, State1, W3, Round + 12);
+		}
+
+		State0 = _mm_add_epi32(State0, Save0);
+		State1 = _mm_add_epi32(State1, Save1);
+	}
+
+	const __m128i FEBA = _mm_shuffle_epi32(State0, 0b00'01'10'11);
+	const __m128i DCHG = _mm_shuffle_epi32(State1, 0b10'11'00'01);
+	_mm_storeu_si128(
+		reinterpret_cast<__m128i*>(State.data()),
+		_mm_blend_epi16(FEBA, DCHG, 0xF0));
+	_mm_storeu_si128(
+		reinterpret_cast<__m128i*>(State.data() + 4),
+		_mm_alignr_epi8(DCHG, FEBA, 8));
+}
+
+// The multi-buffer kernels hold one lane in each 32-bit element of a vector,
+// and run the rounds of the scalar algorithm on all of them at once. Blocks
+// are loaded one lane to each register and then transposed, so that each
+// register holds the same message word of every lane.
+
+TARGET_AVX2 static inline __m256i Rotr_AVX2(__m256i Value, int Shift)
+{
+	return _mm256_or_si256(
+		_mm256_srli_epi32(Value, Shift), _mm256_slli_epi32(Value, 32 - Shift));
+}
+
+TARGET_AVX2 static inline __m256i
+	Xor3_AVX2(__m256i A, __m256i B, __m256i C)
+{
+	return _mm256_xor_si256(_mm256_xor_si256(A, B), C);
+}
+
+// One round, where the working variables have been rotated into place by the
+// caller rather than moved
+TARGET_AVX2 static inline void Round_AVX2(
+	__m256i A, __m256i B, __m256i C, __m256i& D, __m256i E, __m256i F,
+	__m256i G, __m256i& H, __m256i WK)
+{
+	const __m256i S1
+		= Xor3_AVX2(Rotr_AVX2(E, 6), Rotr_AVX2(E, 11), Rotr_AVX2(E, 25));
+	const __m256i Ch = _mm256_xor_si256(
+		_mm256_and_si256(E, F), _mm256_andnot_si256(E, G));
+	const __m256i T1 = _mm256_add_epi32(
+		_mm256_add_epi32(H, WK), _mm256_add_epi32(S1, Ch));
+
+	const __m256i S0
+		= Xor3_AVX2(Rotr_AVX2(A, 2), Rotr_AVX2(A, 13), Rotr_AVX2(A, 22));
+	const __m256i Maj = _mm256_or_si256(
+		_mm256_and_si256(A, B), _mm256_and_si256(C, _mm256_or_si256(A, B)));
+
+	D = _mm256_add_epi32(D, T1);
+	H = _mm256_add_epi32(T1, _mm256_add_epi32(S0, Maj));
+}
+
+// Schedules message word t in place of the one sixteen before it, and returns
+// it added to its round constant
+TARGET_AVX2 static inline __m256i Schedule_AVX2(__m256i* W, std::size_t t)
+{
+	if( t >= 16 )
+	{
+		const __m256i W15 = W[(t - 15) % 16];
+		const __m256i W2  = W[(t - 2) % 16];
+		const __m256i S0  = Xor3_AVX2(
+			Rotr_AVX2(W15, 7), Rotr_AVX2(W15, 18), _mm256_srli_epi32(W15, 3));
+		const __m256i S1 = Xor3_AVX2(
+			Rotr_AVX2(W2, 17), Rotr_AVX2(W2, 19), _mm256_srli_epi32(W2, 10));
+		W[t % 16] = _mm256_add_epi32(
+			_mm256_add_epi32(W[t % 16], S0),
+			_mm256_add_epi32(W[(t - 7) % 16], S1));
+	}
+	return _mm256_add_epi32(W[t % 16], _mm256_set1_epi32(RoundConstants[t]));
+}
+
+// Transposes eight rows of eight 32-bit elements
+TARGET_AVX2 static inline void Transpose8x8_AVX2(__m256i* Rows)
+{
+	__m256i Pairs[8];
+	for( std::size_t i = 0; i < 8; i += 2 )
+	{
+		Pairs[i + 0] = _mm256_unpacklo_epi32(Rows[i], Rows[i + 1]);
+		Pairs[i + 1] = _mm256_unpackhi_epi32(Rows[i], Rows[i + 1]);
+	}
+
+	// Quads[4 * q + c] holds element 4 * l + c of rows 4 * q to 4 * q + 3,
+	// within each 128-bit lane l
+	__m256i Quads[8];
+	for( std::size_t i = 0; i < 8; i += 4 )
+	{
+		Quads[i + 0] = _mm256_unpacklo_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 1] = _mm256_unpackhi_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 2] = _mm256_unpacklo_epi64(Pairs[i + 1], Pairs[i + 3]);
+		Quads[i + 3] = _mm256_unpackhi_epi64(Pairs[i + 1], Pairs[i + 3]);
+	}
+
+	for( std::size_t c = 0; c < 4; ++c )
+	{
+		Rows[c + 0] = _mm256_permute2x128_si256(Quads[c], Quads[c + 4], 0x20);
+		Rows[c + 4] = _mm256_permute2x128_si256(Quads[c], Quads[c + 4], 0x31);
+	}
+}
+
+TARGET_AVX2 static void CompressLanes_AVX2(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount)
+{
+	const __m256i ByteSwap = _mm256_set_epi64x(
+		0x0C0D0E0F08090A0Bull, 0x0405060700010203ull, 0x0C0D0E0F08090A0Bull,
+		0x0405060700010203ull);
+
+	__m256i Vars[8];
+	for( std::size_t i = 0; i < 8; ++i )
+	{
+		Vars[i] = _mm256_load_si256(
+			reinterpret_cast<const __m256i*>(State[i].data()));
+	}
+
+	for( std::size_t j = 0; j < BlockCount; ++j )
+	{
+		__m256i W[16];
+		for( std::size_t i = 0; i < 8; ++i )
+		{
+			const __m256i* Block = reinterpret_cast<const __m256i*>(
+				Inputs[i] ? Inputs[i] + j * BlockSize : ZeroBlock.data());
+			W[i + 0] = _mm256_shuffle_epi8(
+				_mm256_loadu_si256(Block + 0), ByteSwap);
+			W[i + 8] = _mm256_shuffle_epi8(
+				_mm256_loadu_si256(Block + 1), ByteSwap);
+		}
+		Transpose8x8_AVX2(W + 0);
+		Transpose8x8_AVX2(W + 8);
+
+		__m256i A = Vars[0], B = Vars[1], C = Vars[2], D = Vars[3];
+		__m256i E = Vars[4], F = Vars[5], G = Vars[6], H = Vars[7];
+
+		for( std::size_t t = 0; t < 64; t += 8 )
+		{
+			Round_AVX2(A, B, C, D, E, F, G, H, Schedule_AVX2(W, t + 0));
+			Round_AVX2(H, A, B, C, D, E, F, G, Schedule_AVX2(W, t + 1));
+			Round_AVX2(G, H, A, B, C, D, E, F, Schedule_AVX2(W, t + 2));
+			Round_AVX2(F, G, H, A, B, C, D, E, Schedule_AVX2(W, t + 3));
+			Round_AVX2(E, F, G, H, A, B, C, D, Schedule_AVX2(W, t + 4));
+			Round_AVX2(D, E, F, G, H, A, B, C, Schedule_AVX2(W, t + 5));
+			Round_AVX2(C, D, E, F, G, H, A, B, Schedule_AVX2(W, t + 6));
+			Round_AVX2(B, C, D, E, F, G, H, A, Schedule_AVX2(W, t + 7));
+		}
+
+		Vars[0] = _mm256_add_epi32(Vars[0], A);
+		Vars[1] = _mm256_add_epi32(Vars[1], B);
+		Vars[2] = _mm256_add_epi32(Vars[2], C);
+		Vars[3] = _mm256_add_epi32(Vars[3], D);
+		Vars[4] = _mm256_add_epi32(Vars[4], E);
+		Vars[5] = _mm256_add_epi32(Vars[5], F);
+		Vars[6] = _mm256_add_epi32(Vars[6], G);
+		Vars[7] = _mm256_add_epi32(Vars[7], H);
+	}
+
+	for( std::size_t i = 0; i < 8; ++i )
+	{
+		_mm256_store_si256(
+			reinterpret_cast<__m256i*>(State[i].data()), Vars[i]);
+	}
+}
+
+// GCC 12 passes undefined vectors as the sources of its unmasked AVX-512
+// intrinsics and then reports them as uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+TARGET_AVX512 static inline __m512i
+	Xor3_AVX512(__m512i A, __m512i B, __m512i C)
+{
+	return _mm512_ternarylogic_epi32(A, B, C, 0x96);
+}
+
+TARGET_AVX512 static inline void Round_AVX512(
+	__m512i A, __m512i B, __m512i C, __m512i& D, __m512i E, __m512i F,
+	__m512i G, __m512i& H, __m512i WK)
+{
+	const __m512i S1 = Xor3_AVX512(
+		_mm512_ror_epi32(E, 6), _mm512_ror_epi32(E, 11),
+		_mm512_ror_epi32(E, 25));
+	// (E & F) ^ (~E & G)
+	const __m512i Ch = _mm512_ternarylogic_epi32(E, F, G, 0xCA);
+	const __m512i T1 = _mm512_add_epi32(
+		_mm512_add_epi32(H, WK), _mm512_add_epi32(S1, Ch));
+
+	const __m512i S0 = Xor3_AVX512(
+		_mm512_ror_epi32(A, 2), _mm512_ror_epi32(A, 13),
+		_mm512_ror_epi32(A, 22));
+	// (A & B) | (C & (A | B))
+	const __m512i Maj = _mm512_ternarylogic_epi32(A, B, C, 0xE8);
+
+	D = _mm512_add_epi32(D, T1);
+	H = _mm512_add_epi32(T1, _mm512_add_epi32(S0, Maj));
+}
+
+TARGET_AVX512 static inline __m512i Schedule_AVX512(__m512i* W, std::size_t t)
+{
+	if( t >= 16 )
+	{
+		const __m512i W15 = W[(t - 15) % 16];
+		const __m512i W2  = W[(t - 2) % 16];
+		const __m512i S0  = Xor3_AVX512(
+			_mm512_ror_epi32(W15, 7), _mm512_ror_epi32(W15, 18),
+			_mm512_srli_epi32(W15, 3));
+		const __m512i S1 = Xor3_AVX512(
+			_mm512_ror_epi32(W2, 17), _mm512_ror_epi32(W2, 19),
+			_mm512_srli_epi32(W2, 10));
+		W[t % 16] = _mm512_add_epi32(
+			_mm512_add_epi32(W[t % 16], S0),
+			_mm512_add_epi32(W[(t - 7) % 16], S1));
+	}
+	return _mm512_add_epi32(W[t % 16], _mm512_set1_epi32(RoundConstants[t]));
+}
+
+// Transposes sixteen rows of sixteen 32-bit elements
+TARGET_AVX512 static inline void Transpose16x16_AVX512(__m512i* Rows)
+{
+	__m512i Pairs[16];
+	for( std::size_t i = 0; i < 16; i += 2 )
+	{
+		Pairs[i + 0] = _mm512_unpacklo_epi32(Rows[i], Rows[i + 1]);
+		Pairs[i + 1] = _mm512_unpackhi_epi32(Rows[i], Rows[i + 1]);
+	}
+
+	// Quads[4 * q + c] holds element 4 * l + c of rows 4 * q to 4 * q + 3,
+	// within each 128-bit lane l
+	__m512i Quads[16];
+	for( std::size_t i = 0; i < 16; i += 4 )
+	{
+		Quads[i + 0] = _mm512_unpacklo_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 1] = _mm512_unpackhi_epi64(Pairs[i + 0], Pairs[i + 2]);
+		Quads[i + 2] = _mm512_unpacklo_epi64(Pairs[i + 1], Pairs[i + 3]);
+		Quads[i + 3] = _mm512_unpackhi_epi64(Pairs[i + 1], Pairs[i + 3]);
+	}
+
+	// What is left is to transpose the 128-bit lanes of each group of four
+	for( std::size_t c = 0; c < 4; ++c )
+	{
+		const __m512i Lo01
+			= _mm512_shuffle_i32x4(Quads[c + 0], Quads[c + 4], 0b01'00'01'00);
+		const __m512i Hi01
+			= _mm512_shuffle_i32x4(Quads[c + 0], Quads[c + 4], 0b11'10'11'10);
+		const __m512i Lo23
+			= _mm512_shuffle_i32x4(Quads[c + 8], Quads[c + 12], 0b01'00'01'00);
+		const __m512i Hi23
+			= _mm512_shuffle_i32x4(Quads[c + 8], Quads[c + 12], 0b11'10'11'10);
+
+		Rows[c + 0]  = _mm512_shuffle_i32x4(Lo01, Lo23, 0b10'00'10'00);
+		Rows[c + 4]  = _mm512_shuffle_i32x4(Lo01, Lo23, 0b11'01'11'01);
+		Rows[c + 8]  = _mm512_shuffle_i32x4(Hi01, Hi23, 0b10'00'10'00);
+		Rows[c + 12] = _mm512_shuffle_i32x4(Hi01, Hi23, 0b11'01'11'01);
+	}
+}
+
+TARGET_AVX512 static void CompressLanes_AVX512(
+	LaneStateT& State, std::span<const std::byte* const, MaxLanes> Inputs,
+	std::size_t BlockCount)
+{
+	const __m512i ByteSwap = _mm512_broadcast_i32x4(
+		_mm_set_epi64x(0x0C0D0E0F08090A0Bull, 0x0405060700010203ull));
+
+	__m512i Vars[8];
+	for( std::size_t i = 0; i < 8; ++i )
+	{
+		Vars[i] = _mm512_load_si512(State[i].data());
+	}
+
+	for( std::size_t j = 0; j < BlockCount; ++j )
+	{
+		__m512i W[16];
+		for( std::size_t i = 0; i < 16; ++i )
+		{
+			W[i] = _mm512_shuffle_epi8(
+				_mm512_loadu_si512(
+					Inputs[i] ? Inputs[i] + j * BlockSize : ZeroBlock.data()),
+				ByteSwap);
+		}
+		Transpose16x16_AVX512(W);
+
+		__m512i A = Vars[0], B = Vars[1], C = Vars[2], D = Vars[3];
+		__m512i E = Vars[4], F = Vars[5], G = Vars[6], H = Vars[7];
+
+		for( std::size_t t = 0; t < 64; t += 8 )
+		{
+			Round_AVX512(A, B, C, D, E, F, G, H, Schedule_AVX512(W, t + 0));
+			Round_AVX512(H, A, B, C, D, E, F, G, Schedule_AVX512(W, t + 1));
+			Round_AVX512(G, H, A, B, C, D, E, F, Schedule_AVX512(W, t + 2));
+			Round_AVX512(F, G, H, A, B, C, D, E, Schedule_AVX512(W, t + 3));
+			Round_AVX512(E, F, G, H, A, B, C, D, Schedule_AVX512(W, t + 4));
+			Round_AVX512(D, E, F, G, H, A, B, C, Schedule_AVX512(W, t + 5));
+			Round_AVX512(C, D, E, F, G, H, A, B, Schedule_AVX512(W, t + 6));
+			Round_AVX512(B, C, D, E, F, G, H, A, Schedule_AVX512(W, t + 7));
+		}
+
+		Vars[0] = _mm512_add_epi32(Vars[0], A);
+		Vars[1] = _mm512_add_epi32(Vars[1], B);
+		Vars[2] = _mm512_add_epi32(Vars[2], C);
+		Vars[3] = _mm512_add_epi32(Vars[3], D);
+		Vars[4] = _mm512_add_epi32(Vars[4], E);
+		Vars[5] = _mm512_add_epi32(Vars[5], F);
+		Vars[6] = _mm512_add_epi32(Vars[6], G);
+		Vars[7] = _mm512_add_epi32(Vars[7], H);
+	}
+
+	for( std::size_t i = 0; i < 8; ++i )
+	{
+		_mm512_store_si512(State[i].data(), Vars[i]);
+	}
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static CompressT SelectCompress()
+{
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") )
+	{
+		return Compress_SHA;
+	}
+	return Compress_Scalar;
+}
+
+CompressT GetCompress()
+{
+	static const CompressT CompressImpl = SelectCompress();
+	return CompressImpl;
+}
+
+static CompressLanesKernel SelectCompressLanes()
+{
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("avx512f")
+		&& __builtin_cpu_supports("avx512bw") )
+	{
+		return {CompressLanes_AVX512, 16};
+	}
+	// Eight lanes of AVX2 are still slower than one of the SHA extensions
+	else if( __builtin_cpu_supports("avx2") && !__builtin_cpu_supports("sha") )
+	{
+		return {CompressLanes_AVX2, 8};
+	}
+	return {};
+}
+
+CompressLanesKernel GetCompressLanes()
+{
+	static const CompressLanesKernel CompressLanesImpl = SelectCompressLanes();
+	return CompressLanesImpl;
+}
+
+} // namespace SHA
+
+#endif
@@ -0,0 +1,330 @@
+#include <SHA256.hpp>
+
+#include "SHA256-Compress.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace SHA
+{
+
+static std::uint32_t ReadBigEndian32(const std::byte* Data)
+{
+	std::uint32_t Value;
+	std::memcpy(&Value, Data, sizeof(Value));
+	if constexpr( std::endian::native == std::endian::little )
+	{
+		Value = __builtin_bswap32(Value);
+	}
+	return Value;
+}
+
+void Compress_Scalar(
+	std::span<std::uint32_t, 8> State, const std::byte* Input,
+	std::size_t BlockCount)
+{
+	for( std::size_t i = 0; i < BlockCount; ++i, Input += BlockSize )
+	{
+		std::array<std::uint32_t, 64> W;
+		for( std::size_t t = 0; t < 16; ++t )
+		{
+			W[t] = ReadBigEndian32(Input + t * 4);
+		}
+		for( std::size_t t = 16; t < 64; ++t )
+		{
+			const std::uint32_t W15 = W[t - 15];
+			const std::uint32_t W2  = W[t - 2];
+			const std::uint32_t S0
+				= std::rotr(W15, 7) ^ std::rotr(W15, 18) ^ (W15 >> 3);
+			const std::uint32_t S1
+				= std::rotr(W2, 17) ^ std::rotr(W2, 19) ^ (W2 >> 10);
+			W[t] = W[t - 16] + S0 + W[t - 7] + S1;
+		}
+
+		std::uint32_t A = State[0], B = State[1], C = State[2], D = State[3];
+		std::uint32_t E = State[4], F = State[5], G = State[6], H = State[7];
+		for( std::size_t t = 0; t < 64; ++t )
+		{
+			const std::uint32_t S1
+				= std::rotr(E, 6) ^ std::rotr(E, 11) ^ std::rotr(E, 25);
+			const std::uint32_t Ch = (E & F) ^ (~E & G);
+			const std::uint32_t T1 = H + S1 + Ch + RoundConstants[t] + W[t];
+			const std::uint32_t S0
+				= std::rotr(A, 2) ^ std::rotr(A, 13) ^ std::rotr(A, 22);
+			const std::uint32_t Maj = (A & B) ^ (A & C) ^ (B & C);
+			const std::uint32_t T2  = S0 + Maj;
+
+			H = G;
+			G = F;
+			F = E;
+			E = D + T1;
+			D = C;
+			C = B;
+			B = A;
+			A = T1 + T2;
+		}
+		State[0] += A;
+		State[1] += B;
+		State[2] += C;
+		State[3] += D;
+		State[4] += E;
+		State[5] += F;
+		State[6] += G;
+		State[7] += H;
+	}
+}
+
+#if !defined(_M_X64) && !defined(__amd64__) && !defined(__aarch64__)
+CompressT GetCompress()
+{
+	return Compress_Scalar;
+}
+
+CompressLanesKernel GetCompressLanes()
+{
+	return {};
+}
+#endif
+
+static Digest256 ToDigest(std::span<const std::uint32_t, 8> State)
+{
+	Digest256 Result;
+	for( std::size_t i = 0; i < State.size(); ++i )
+	{
+		Result[i * 4 + 0] = std::uint8_t(State[i] >> 24);
+		Result[i * 4 + 1] = std::uint8_t(State[i] >> 16);
+		Result[i * 4 + 2] = std::uint8_t(State[i] >> 8);
+		Result[i * 4 + 3] = std::uint8_t(State[i] >> 0);
+	}
+	return Result;
+}
+
+// Pads the last, partial, block of an input of Length bytes into Tail and
+// returns how many blocks it now takes up
+static std::size_t PadTail(
+	std::span<const std::byte> Remainder, std::uint64_t Length,
+	std::span<std::byte, BlockSize * 2> Tail)
+{
+	const std::size_t TailBlocks
+		= Remainder.size() + 1 + sizeof(Length) > BlockSize ? 2 : 1;
+
+	std::fill(Tail.begin(), Tail.end(), std::byte{0});
+	std::copy(Remainder.begin(), Remainder.end(), Tail.begin());
+	Tail[Remainder.size()] = std::byte{0x80};
+
+	const std::uint64_t BitLength = Length * 8;
+	for( std::size_t i = 0; i < sizeof(BitLength); ++i )
+	{
+		Tail[TailBlocks * BlockSize - 1 - i] = std::byte(BitLength >> (i * 8));
+	}
+	return TailBlocks;
+}
+
+Digest256 Hash256(std::span<const std::byte> Data)
+{
+	Hasher CurHasher;
+	CurHasher.Update(Data);
+	return CurHasher.Finalize();
+}
+
+// Reads the state of one lane back out of the states of all of them
+static std::array<std::uint32_t, 8>
+	LaneState(const LaneStateT& State, std::size_t LaneIndex)
+{
+	std::array<std::uint32_t, 8> Result;
+	for( std::size_t i = 0; i < Result.size(); ++i )
+	{
+		Result[i] = State[i][LaneIndex];
+	}
+	return Result;
+}
+
+// The input being hashed within one lane. Its whole blocks are compressed
+// straight from the input, and then its padded tail.
+struct LaneInput
+{
+	std::size_t InputIndex;
+	std::size_t BlocksLeft;
+	bool        InTail;
+
+	alignas(64) std::array<std::byte, BlockSize * 2> Tail;
+	std::size_t TailBlocks;
+};
+
+void Hash256(
+	std::span<const std::span<const std::byte>> Inputs,
+	std::span<Digest256>                         Digests)
+{
+	const CompressLanesKernel Kernel = GetCompressLanes();
+	if( !Kernel.Compress )
+	{
+		for( std::size_t i = 0; i < Inputs.size(); ++i )
+		{
+			Digests[i] = Hash256(Inputs[i]);
+		}
+		return;
+	}
+
+	alignas(64) LaneStateT State;
+	std::array<LaneInput, MaxLanes>        Lanes;
+	std::array<const std::byte*, MaxLanes> LaneBlocks = {};
+	std::size_t                            NextInput  = 0;
+
+	// Starts the next input within a lane, or leaves the lane idle once there
+	// are none left
+	const auto BeginLane = [&](std::size_t LaneIndex) {
+		LaneInput& CurLane = Lanes[LaneIndex];
+		if( NextInput == Inputs.size() )
+		{
+			LaneBlocks[LaneIndex] = nullptr;
+			return;
+		}
+
+		const std::span<const std::byte> Input = Inputs[NextInput];
+		const std::size_t WholeBlocks          = Input.size() / BlockSize;
+
+		CurLane.InputIndex = NextInput++;
+		CurLane.TailBlocks = PadTail(
+			Input.subspan(WholeBlocks * BlockSize), Input.size(),
+			CurLane.Tail);
+		CurLane.InTail = WholeBlocks == 0;
+		CurLane.BlocksLeft
+			= CurLane.InTail ? CurLane.TailBlocks : WholeBlocks;
+		LaneBlocks[LaneIndex]
+			= CurLane.InTail ? CurLane.Tail.data() : Input.data();
+
+		for( std::size_t i = 0; i < InitialState.size(); ++i )
+		{
+			State[i][LaneIndex] = InitialState[i];
+		}
+	};
+
+	for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+	{
+		BeginLane(i);
+	}
+
+	while( true )
+	{
+		std::size_t BlockCount  = std::numeric_limits<std::size_t>::max();
+		std::size_t ActiveLanes = 0;
+		std::size_t LastLane    = 0;
+		for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+		{
+			if( LaneBlocks[i] )
+			{
+				BlockCount = std::min(BlockCount, Lanes[i].BlocksLeft);
+				++ActiveLanes;
+				LastLane = i;
+			}
+		}
+
+		if( ActiveLanes == 0 )
+		{
+			return;
+		}
+
+		// Lanes are only ever left idle once every input has begun, so the
+		// last input is finished on its own rather than in one lane of many
+		if( ActiveLanes == 1 )
+		{
+			const LaneInput& CurLane = Lanes[LastLane];
+
+			std::array<std::uint32_t, 8> LastState
+				= LaneState(State, LastLane);
+
+			const CompressT Compress = GetCompress();
+			Compress(LastState, LaneBlocks[LastLane], CurLane.BlocksLeft);
+			if( !CurLane.InTail )
+			{
+				Compress(LastState, CurLane.Tail.data(), CurLane.TailBlocks);
+			}
+
+			Digests[CurLane.InputIndex] = ToDigest(LastState);
+			return;
+		}
+
+		Kernel.Compress(State, LaneBlocks, BlockCount);
+
+		for( std::size_t i = 0; i < Kernel.LaneCount; ++i )
+		{
+			LaneInput& CurLane = Lanes[i];
+			if( !LaneBlocks[i] )
+			{
+				continue;
+			}
+
+			LaneBlocks[i] += BlockCount * BlockSize;
+			CurLane.BlocksLeft -= BlockCount;
+			if( CurLane.BlocksLeft )
+			{
+				continue;
+			}
+
+			if( !CurLane.InTail )
+			{
+				CurLane.InTail     = true;
+				CurLane.BlocksLeft = CurLane.TailBlocks;
+				LaneBlocks[i]      = CurLane.Tail.data();
+				continue;
+			}
+
+			Digests[CurLane.InputIndex] = ToDigest(LaneState(State, i));
+
+			BeginLane(i);
+		}
+	}
+}
+
+Hasher::Hasher() : State(InitialState)
+{
+}
+
+void Hasher::Update(std::span<const std::byte> Data)
+{
+	TotalLength += Data.size();
+
+	if( BufferSize + Data.size() < Buffer.size() )
+	{
+		std::copy(Data.begin(), Data.end(), Buffer.begin() + BufferSize);
+		BufferSize += Data.size();
+		return;
+	}
+
+	const CompressT Compress = GetCompress();
+
+	// Top off the buffer and compress all of it
+	if( BufferSize )
+	{
+		const std::size_t LoadSize = Buffer.size() - BufferSize;
+		std::copy_n(Data.begin(), LoadSize, Buffer.begin() + BufferSize);
+		Data = Data.subspan(LoadSize);
+
+		Compress(State, Buffer.data(), 1);
+		BufferSize = 0;
+	}
+
+	// Compress whole blocks directly from the input
+	const std::size_t BlockCount = Data.size() / BlockSize;
+	Compress(State, Data.data(), BlockCount);
+	Data = Data.subspan(BlockCount * BlockSize);
+
+	std::copy(Data.begin(), Data.end(), Buffer.begin());
+	BufferSize = Data.size();
+}
+
+Digest256 Hasher::Finalize() const
+{
+	std::array<std::uint32_t, 8> FinalState = State;
+
+	alignas(64) std::array<std::byte, BlockSize * 2> Tail;
+	const std::size_t                                TailBlocks
+		= PadTail(std::span(Buffer).first(BufferSize), TotalLength, Tail);
+	GetCompress()(FinalState, Tail.data(), TailBlocks);
+
+	return ToDigest(FinalState);
+}
+
+} // namespace SHA
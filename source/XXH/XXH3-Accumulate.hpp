@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace XXH
+{
+
+// Long inputs are accumulated as 64-byte stripes into eight 64-bit lanes. Each
+// stripe is keyed with the secret 8 bytes further along than the last, until a
+// block of StripesPerBlock stripes is done and the lanes are scrambled with the
+// last stripe of the secret.
+inline constexpr std::size_t StripeSize      = 64;
+inline constexpr std::size_t SecretSize      = 192;
+inline constexpr std::size_t StripesPerBlock = (SecretSize - StripeSize) / 8;
+inline constexpr std::size_t ScrambleOffset  = SecretSize - StripeSize;
+
+alignas(64) inline constexpr std::array<std::uint8_t, SecretSize> Secret = {
+	0xB8, 0xFE, 0x6C, 0x39, 0x23, 0xA4, 0x4B, 0xBE, 0x7C, 0x01, 0x81, 0x2C,
+	0xF7, 0x21, 0xAD, 0x1C, 0xDE, 0xD4, 0x6D, 0xE9, 0x83, 0x90, 0x97, 0xDB,
+	0x72, 0x40, 0xA4, 0xA4, 0xB7, 0xB3, 0x67, 0x1F, 0xCB, 0x79, 0xE6, 0x4E,
+	0xCC, 0xC0, 0xE5, 0x78, 0x82, 0x5A, 0xD0, 0x7D, 0xCC, 0xFF, 0x72, 0x21,
+	0xB8, 0x08, 0x46, 0x74, 0xF7, 0x43, 0x24, 0x8E, 0xE0, 0x35, 0x90, 0xE6,
+	0x81, 0x3A, 0x26, 0x4C, 0x3C, 0x28, 0x52, 0xBB, 0x91, 0xC3, 0x00, 0xCB,
+	0x88, 0xD0, 0x65, 0x8B, 0x1B, 0x53, 0x2E, 0xA3, 0x71, 0x64, 0x48, 0x97,
+	0xA2, 0x0D, 0xF9, 0x4E, 0x38, 0x19, 0xEF, 0x46, 0xA9, 0xDE, 0xAC, 0xD8,
+	0xA8, 0xFA, 0x76, 0x3F, 0xE3, 0x9C, 0x34, 0x3F, 0xF9, 0xDC, 0xBB, 0xC7,
+	0xC7, 0x0B, 0x4F, 0x1D, 0x8A, 0x51, 0xE0, 0x4B, 0xCD, 0xB4, 0x59, 0x31,
+	0xC8, 0x9F, 0x7E, 0xC9, 0xD9, 0x78, 0x73, 0x64, 0xEA, 0xC5, 0xAC, 0x83,
+	0x34, 0xD3, 0xEB, 0xC3, 0xC5, 0x81, 0xA0, 0xFF, 0xFA, 0x13, 0x63, 0xEB,
+	0x17, 0x0D, 0xDD, 0x51, 0xB7, 0xF0, 0xDA, 0x49, 0xD3, 0x16, 0x55, 0x26,
+	0x29, 0xD4, 0x68, 0x9E, 0x2B, 0x16, 0xBE, 0x58, 0x7D, 0x47, 0xA1, 0xFC,
+	0x8F, 0xF8, 0xB8, 0xD1, 0x7A, 0xD0, 0x31, 0xCE, 0x45, 0xCB, 0x3A, 0x8F,
+	0x95, 0x16, 0x04, 0x28, 0xAF, 0xD7, 0xFB, 0xCA, 0xBB, 0x4B, 0x40, 0x7E,
+};
+
+inline constexpr std::uint32_t Prime32_1 = 0x9E3779B1u;
+inline constexpr std::uint32_t Prime32_2 = 0x85EBCA77u;
+inline constexpr std::uint32_t Prime32_3 = 0xC2B2AE3Du;
+
+// Accumulates StripeCount stripes of Input into Acc, carrying on from the
+// StripeIndex-th stripe of the current block. Returns the index within its
+// block of the stripe that would come next.
+using AccumulateT = std::size_t (*)(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount);
+
+std::size_t Accumulate_Scalar(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount);
+
+// The fastest accumulation kernel of the host, resolved once, upon first use
+AccumulateT GetAccumulate();
+
+} // namespace XXH
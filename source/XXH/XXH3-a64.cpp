@@ -0,0 +1,99 @@
+#if defined(__aarch64__)
+
+#include <XXH3.hpp>
+
+#include "XXH3-Accumulate.hpp"
+
+#include <algorithm>
+
+#include <arm_neon.h>
+
+namespace XXH
+{
+
+// The eight lanes are held in four 128-bit registers for the duration of the
+// call, and only written back once all of the stripes are done. Lanes only
+// ever take sums of their input in between scrambles, so each block of input
+// is summed up and swapped into the adjacent lanes just once, at its end.
+static std::size_t Accumulate_NEON(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount)
+{
+	const uint32x2_t Prime32 = vdup_n_u32(Prime32_1);
+
+	uint64x2_t AccVec[4];
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		AccVec[i] = vld1q_u64(Acc.data() + i * 2);
+	}
+
+	while( StripeCount )
+	{
+		const std::size_t BlockStripes
+			= std::min(StripeCount, StripesPerBlock - StripeIndex);
+
+		uint64x2_t DataSum[4] = {};
+		for( std::size_t j = 0; j < BlockStripes; ++j )
+		{
+			const std::uint8_t* Stripe
+				= reinterpret_cast<const std::uint8_t*>(Input)
+				+ j * StripeSize;
+			const std::uint8_t* Key = Secret.data() + (StripeIndex + j) * 8;
+
+			for( std::size_t i = 0; i < 4; ++i )
+			{
+				const uint64x2_t Data
+					= vreinterpretq_u64_u8(vld1q_u8(Stripe + i * 16));
+				const uint64x2_t DataKey = veorq_u64(
+					Data, vreinterpretq_u64_u8(vld1q_u8(Key + i * 16)));
+
+				DataSum[i] = vaddq_u64(DataSum[i], Data);
+				AccVec[i]  = vmlal_u32(
+					AccVec[i], vmovn_u64(DataKey), vshrn_n_u64(DataKey, 32));
+			}
+		}
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			AccVec[i] = vaddq_u64(
+				AccVec[i], vextq_u64(DataSum[i], DataSum[i], 1));
+		}
+
+		Input += BlockStripes * StripeSize;
+		StripeCount -= BlockStripes;
+		StripeIndex += BlockStripes;
+
+		if( StripeIndex == StripesPerBlock )
+		{
+			const std::uint8_t* Key = Secret.data() + ScrambleOffset;
+
+			for( std::size_t i = 0; i < 4; ++i )
+			{
+				uint64x2_t Lane
+					= veorq_u64(AccVec[i], vshrq_n_u64(AccVec[i], 47));
+				Lane = veorq_u64(
+					Lane, vreinterpretq_u64_u8(vld1q_u8(Key + i * 16)));
+
+				const uint64x2_t ProductHigh = vshlq_n_u64(
+					vmull_u32(vshrn_n_u64(Lane, 32), Prime32), 32);
+				AccVec[i] = vmlal_u32(ProductHigh, vmovn_u64(Lane), Prime32);
+			}
+			StripeIndex = 0;
+		}
+	}
+
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		vst1q_u64(Acc.data() + i * 2, AccVec[i]);
+	}
+	return StripeIndex;
+}
+
+// NEON is a part of every AArch64 processor
+AccumulateT GetAccumulate()
+{
+	return Accumulate_NEON;
+}
+
+} // namespace XXH
+
+#endif
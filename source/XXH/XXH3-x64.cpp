@@ -0,0 +1,271 @@
+#if defined(_M_X64) || defined(__amd64__)
+
+#include <XXH3.hpp>
+
+#include "XXH3-Accumulate.hpp"
+
+#include <algorithm>
+
+#include <immintrin.h>
+
+namespace XXH
+{
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx2,avx512f")))
+
+// Each kernel keeps the eight lanes in as few registers as its vector-width
+// allows, and only writes them back once all of the stripes are done. Lanes
+// only ever take sums of their input in between scrambles, so each block of
+// input is summed apart from its products and swapped into the adjacent lanes
+// just once, at the end of the block.
+
+static std::size_t Accumulate_SSE2(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount)
+{
+	const __m128i Prime32 = _mm_set1_epi32(Prime32_1);
+
+	__m128i AccVec[4];
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		AccVec[i] = _mm_load_si128(
+			reinterpret_cast<const __m128i*>(Acc.data()) + i);
+	}
+
+	while( StripeCount )
+	{
+		const std::size_t BlockStripes
+			= std::min(StripeCount, StripesPerBlock - StripeIndex);
+
+		__m128i DataSum[4]    = {};
+		__m128i ProductSum[4] = {};
+		for( std::size_t j = 0; j < BlockStripes; ++j )
+		{
+			const __m128i* Stripe = reinterpret_cast<const __m128i*>(
+				Input + j * StripeSize);
+			const __m128i* Key = reinterpret_cast<const __m128i*>(
+				Secret.data() + (StripeIndex + j) * 8);
+
+			for( std::size_t i = 0; i < 4; ++i )
+			{
+				const __m128i Data    = _mm_loadu_si128(Stripe + i);
+				const __m128i DataKey = _mm_xor_si128(
+					Data, _mm_loadu_si128(Key + i));
+				ProductSum[i] = _mm_add_epi64(
+					ProductSum[i],
+					_mm_mul_epu32(DataKey, _mm_srli_epi64(DataKey, 32)));
+				DataSum[i] = _mm_add_epi64(DataSum[i], Data);
+			}
+		}
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			AccVec[i] = _mm_add_epi64(
+				AccVec[i],
+				_mm_add_epi64(
+					ProductSum[i],
+					_mm_shuffle_epi32(DataSum[i], 0b01'00'11'10)));
+		}
+
+		Input += BlockStripes * StripeSize;
+		StripeCount -= BlockStripes;
+		StripeIndex += BlockStripes;
+
+		if( StripeIndex == StripesPerBlock )
+		{
+			const __m128i* Key = reinterpret_cast<const __m128i*>(
+				Secret.data() + ScrambleOffset);
+
+			for( std::size_t i = 0; i < 4; ++i )
+			{
+				__m128i Lane = _mm_xor_si128(
+					AccVec[i], _mm_srli_epi64(AccVec[i], 47));
+				Lane = _mm_xor_si128(Lane, _mm_loadu_si128(Key + i));
+
+				const __m128i ProductLow  = _mm_mul_epu32(Lane, Prime32);
+				const __m128i ProductHigh = _mm_mul_epu32(
+					_mm_srli_epi64(Lane, 32), Prime32);
+				AccVec[i] = _mm_add_epi64(
+					ProductLow, _mm_slli_epi64(ProductHigh, 32));
+			}
+			StripeIndex = 0;
+		}
+	}
+
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		_mm_store_si128(
+			reinterpret_cast<__m128i*>(Acc.data()) + i, AccVec[i]);
+	}
+	return StripeIndex;
+}
+
+TARGET_AVX2 static std::size_t Accumulate_AVX2(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount)
+{
+	const __m256i Prime32 = _mm256_set1_epi32(Prime32_1);
+
+	__m256i AccVec[2];
+	for( std::size_t i = 0; i < 2; ++i )
+	{
+		AccVec[i] = _mm256_load_si256(
+			reinterpret_cast<const __m256i*>(Acc.data()) + i);
+	}
+
+	while( StripeCount )
+	{
+		const std::size_t BlockStripes
+			= std::min(StripeCount, StripesPerBlock - StripeIndex);
+
+		__m256i DataSum[2]    = {};
+		__m256i ProductSum[2] = {};
+		for( std::size_t j = 0; j < BlockStripes; ++j )
+		{
+			const __m256i* Stripe = reinterpret_cast<const __m256i*>(
+				Input + j * StripeSize);
+			const __m256i* Key = reinterpret_cast<const __m256i*>(
+				Secret.data() + (StripeIndex + j) * 8);
+
+			for( std::size_t i = 0; i < 2; ++i )
+			{
+				const __m256i Data    = _mm256_loadu_si256(Stripe + i);
+				const __m256i DataKey = _mm256_xor_si256(
+					Data, _mm256_loadu_si256(Key + i));
+				ProductSum[i] = _mm256_add_epi64(
+					ProductSum[i],
+					_mm256_mul_epu32(DataKey, _mm256_srli_epi64(DataKey, 32)));
+				DataSum[i] = _mm256_add_epi64(DataSum[i], Data);
+			}
+		}
+		for( std::size_t i = 0; i < 2; ++i )
+		{
+			AccVec[i] = _mm256_add_epi64(
+				AccVec[i],
+				_mm256_add_epi64(
+					ProductSum[i],
+					_mm256_shuffle_epi32(DataSum[i], 0b01'00'11'10)));
+		}
+
+		Input += BlockStripes * StripeSize;
+		StripeCount -= BlockStripes;
+		StripeIndex += BlockStripes;
+
+		if( StripeIndex == StripesPerBlock )
+		{
+			const __m256i* Key = reinterpret_cast<const __m256i*>(
+				Secret.data() + ScrambleOffset);
+
+			for( std::size_t i = 0; i < 2; ++i )
+			{
+				__m256i Lane = _mm256_xor_si256(
+					AccVec[i], _mm256_srli_epi64(AccVec[i], 47));
+				Lane = _mm256_xor_si256(Lane, _mm256_loadu_si256(Key + i));
+
+				const __m256i ProductLow  = _mm256_mul_epu32(Lane, Prime32);
+				const __m256i ProductHigh = _mm256_mul_epu32(
+					_mm256_srli_epi64(Lane, 32), Prime32);
+				AccVec[i] = _mm256_add_epi64(
+					ProductLow, _mm256_slli_epi64(ProductHigh, 32));
+			}
+			StripeIndex = 0;
+		}
+	}
+
+	for( std::size_t i = 0; i < 2; ++i )
+	{
+		_mm256_store_si256(
+			reinterpret_cast<__m256i*>(Acc.data()) + i, AccVec[i]);
+	}
+	return StripeIndex;
+}
+
+// GCC 12 warns of the undefined sources its own AVX-512 intrinsics use
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+TARGET_AVX512 static std::size_t Accumulate_AVX512(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount)
+{
+	const __m512i Prime32 = _mm512_set1_epi32(Prime32_1);
+
+	__m512i AccVec = _mm512_load_si512(Acc.data());
+
+	while( StripeCount )
+	{
+		const std::size_t BlockStripes
+			= std::min(StripeCount, StripesPerBlock - StripeIndex);
+
+		__m512i DataSum    = _mm512_setzero_si512();
+		__m512i ProductSum = _mm512_setzero_si512();
+		for( std::size_t j = 0; j < BlockStripes; ++j )
+		{
+			const __m512i Data = _mm512_loadu_si512(Input + j * StripeSize);
+			const __m512i DataKey = _mm512_xor_si512(
+				Data,
+				_mm512_loadu_si512(Secret.data() + (StripeIndex + j) * 8));
+			ProductSum = _mm512_add_epi64(
+				ProductSum,
+				_mm512_mul_epu32(DataKey, _mm512_srli_epi64(DataKey, 32)));
+			DataSum = _mm512_add_epi64(DataSum, Data);
+		}
+		AccVec = _mm512_add_epi64(
+			AccVec,
+			_mm512_add_epi64(
+				ProductSum, _mm512_shuffle_epi32(DataSum, _MM_PERM_BADC)));
+
+		Input += BlockStripes * StripeSize;
+		StripeCount -= BlockStripes;
+		StripeIndex += BlockStripes;
+
+		if( StripeIndex == StripesPerBlock )
+		{
+			// Acc ^ (Acc >> 47) ^ Key
+			const __m512i Lane = _mm512_ternarylogic_epi32(
+				AccVec, _mm512_srli_epi64(AccVec, 47),
+				_mm512_loadu_si512(Secret.data() + ScrambleOffset), 0x96);
+
+			const __m512i ProductLow  = _mm512_mul_epu32(Lane, Prime32);
+			const __m512i ProductHigh = _mm512_mul_epu32(
+				_mm512_srli_epi64(Lane, 32), Prime32);
+			AccVec = _mm512_add_epi64(
+				ProductLow, _mm512_slli_epi64(ProductHigh, 32));
+			StripeIndex = 0;
+		}
+	}
+
+	_mm512_store_si512(Acc.data(), AccVec);
+	return StripeIndex;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static AccumulateT SelectAccumulate()
+{
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("avx512f") )
+	{
+		return Accumulate_AVX512;
+	}
+	else if( __builtin_cpu_supports("avx2") )
+	{
+		return Accumulate_AVX2;
+	}
+	// SSE2 is a part of every x86-64 processor
+	return Accumulate_SSE2;
+}
+
+AccumulateT GetAccumulate()
+{
+	static const AccumulateT AccumulateImpl = SelectAccumulate();
+	return AccumulateImpl;
+}
+
+} // namespace XXH
+
+#endif
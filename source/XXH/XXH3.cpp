@@ -0,0 +1,495 @@
+#include <XXH3.hpp>
+
+#include "XXH3-Accumulate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace XXH
+{
+
+static constexpr std::uint64_t Prime64_1 = 0x9E3779B185EBCA87ull;
+static constexpr std::uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr std::uint64_t Prime64_3 = 0x165667B19E3779F9ull;
+static constexpr std::uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ull;
+static constexpr std::uint64_t Prime64_5 = 0x27D4EB2F165667C5ull;
+static constexpr std::uint64_t PrimeMx1  = 0x165667919E3779F9ull;
+static constexpr std::uint64_t PrimeMx2  = 0x9FB21C651E98DF25ull;
+
+// Inputs longer than this are accumulated in stripes
+static constexpr std::size_t MidSizeMax = 240;
+
+static constexpr std::array<std::uint64_t, 8> AccInit = {
+	Prime32_3, Prime64_1, Prime64_2, Prime64_3,
+	Prime64_4, Prime32_2, Prime64_5, Prime32_1,
+};
+
+static std::uint32_t Read32(const std::byte* Data)
+{
+	std::uint32_t Value;
+	std::memcpy(&Value, Data, sizeof(Value));
+	return Value;
+}
+
+static std::uint64_t Read64(const std::byte* Data)
+{
+	std::uint64_t Value;
+	std::memcpy(&Value, Data, sizeof(Value));
+	return Value;
+}
+
+static std::uint64_t SecretRead64(std::size_t Offset)
+{
+	return Read64(reinterpret_cast<const std::byte*>(Secret.data()) + Offset);
+}
+
+static std::uint32_t SecretRead32(std::size_t Offset)
+{
+	return Read32(reinterpret_cast<const std::byte*>(Secret.data()) + Offset);
+}
+
+static Digest128 Multiply64To128(std::uint64_t A, std::uint64_t B)
+{
+	const unsigned __int128 Product = (unsigned __int128)A * B;
+	return {std::uint64_t(Product), std::uint64_t(Product >> 64)};
+}
+
+static std::uint64_t Multiply128Fold64(std::uint64_t A, std::uint64_t B)
+{
+	const Digest128 Product = Multiply64To128(A, B);
+	return Product.Low ^ Product.High;
+}
+
+static std::uint64_t XXH64Avalanche(std::uint64_t Hash)
+{
+	Hash ^= Hash >> 33;
+	Hash *= Prime64_2;
+	Hash ^= Hash >> 29;
+	Hash *= Prime64_3;
+	Hash ^= Hash >> 32;
+	return Hash;
+}
+
+static std::uint64_t Avalanche(std::uint64_t Hash)
+{
+	Hash ^= Hash >> 37;
+	Hash *= PrimeMx1;
+	Hash ^= Hash >> 32;
+	return Hash;
+}
+
+static std::uint64_t RRMXMX(std::uint64_t Hash, std::uint64_t Length)
+{
+	Hash ^= std::rotl(Hash, 49) ^ std::rotl(Hash, 24);
+	Hash *= PrimeMx2;
+	Hash ^= (Hash >> 35) + Length;
+	Hash *= PrimeMx2;
+	return Hash ^ (Hash >> 28);
+}
+
+static std::uint64_t Mix16(const std::byte* Data, std::size_t SecretOffset)
+{
+	return Multiply128Fold64(
+		Read64(Data + 0) ^ SecretRead64(SecretOffset + 0),
+		Read64(Data + 8) ^ SecretRead64(SecretOffset + 8));
+}
+
+static void Mix32(
+	Digest128& Acc, const std::byte* DataA, const std::byte* DataB,
+	std::size_t SecretOffset)
+{
+	Acc.Low += Mix16(DataA, SecretOffset);
+	Acc.Low ^= Read64(DataB) + Read64(DataB + 8);
+	Acc.High += Mix16(DataB, SecretOffset + 16);
+	Acc.High ^= Read64(DataA) + Read64(DataA + 8);
+}
+
+static void Accumulate512(
+	std::span<std::uint64_t, 8> Acc, const std::byte* Input,
+	std::size_t SecretOffset)
+{
+	for( std::size_t i = 0; i < 8; ++i )
+	{
+		const std::uint64_t DataValue = Read64(Input + i * 8);
+		const std::uint64_t DataKey
+			= DataValue ^ SecretRead64(SecretOffset + i * 8);
+		Acc[i ^ 1] += DataValue;
+		Acc[i] += std::uint32_t(DataKey) * (DataKey >> 32);
+	}
+}
+
+std::size_t Accumulate_Scalar(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	const std::byte* Input, std::size_t StripeCount)
+{
+	for( std::size_t i = 0; i < StripeCount; ++i )
+	{
+		Accumulate512(Acc, Input + i * StripeSize, StripeIndex * 8);
+
+		if( ++StripeIndex == StripesPerBlock )
+		{
+			for( std::size_t j = 0; j < 8; ++j )
+			{
+				std::uint64_t Lane = Acc[j];
+				Lane ^= Lane >> 47;
+				Lane ^= SecretRead64(ScrambleOffset + j * 8);
+				Lane *= Prime32_1;
+				Acc[j] = Lane;
+			}
+			StripeIndex = 0;
+		}
+	}
+	return StripeIndex;
+}
+
+#if !defined(_M_X64) && !defined(__amd64__) && !defined(__aarch64__)
+AccumulateT GetAccumulate()
+{
+	return Accumulate_Scalar;
+}
+#endif
+
+// Accumulates the final stripe, which always ends at the end of the input and
+// so may overlap the last stripe that was accumulated
+static void AccumulateLastStripe(
+	std::span<std::uint64_t, 8> Acc, const std::byte* LastStripe)
+{
+	Accumulate512(Acc, LastStripe, SecretSize - StripeSize - 7);
+}
+
+static std::uint64_t MergeAccs(
+	std::span<const std::uint64_t, 8> Acc, std::size_t SecretOffset,
+	std::uint64_t Start)
+{
+	std::uint64_t Result = Start;
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		Result += Multiply128Fold64(
+			Acc[i * 2 + 0] ^ SecretRead64(SecretOffset + i * 16 + 0),
+			Acc[i * 2 + 1] ^ SecretRead64(SecretOffset + i * 16 + 8));
+	}
+	return Avalanche(Result);
+}
+
+static std::uint64_t
+	MergeAccs64(std::span<const std::uint64_t, 8> Acc, std::uint64_t Length)
+{
+	return MergeAccs(Acc, 11, Length * Prime64_1);
+}
+
+static Digest128
+	MergeAccs128(std::span<const std::uint64_t, 8> Acc, std::uint64_t Length)
+{
+	return {
+		MergeAccs(Acc, 11, Length * Prime64_1),
+		MergeAccs(Acc, SecretSize - StripeSize - 11, ~(Length * Prime64_2))};
+}
+
+static void AccumulateLong(
+	std::span<std::uint64_t, 8> Acc, std::span<const std::byte> Data)
+{
+	GetAccumulate()(Acc, 0, Data.data(), (Data.size() - 1) / StripeSize);
+	AccumulateLastStripe(Acc, Data.data() + Data.size() - StripeSize);
+}
+
+static std::uint64_t Hash64Short(std::span<const std::byte> Data)
+{
+	const std::byte*    Input  = Data.data();
+	const std::uint64_t Length = Data.size();
+
+	if( Length > 128 )
+	{
+		std::uint64_t Acc = Length * Prime64_1;
+		for( std::size_t i = 0; i < 8; ++i )
+		{
+			Acc += Mix16(Input + i * 16, i * 16);
+		}
+		Acc = Avalanche(Acc);
+
+		for( std::size_t i = 8; i < Length / 16; ++i )
+		{
+			Acc += Mix16(Input + i * 16, (i - 8) * 16 + 3);
+		}
+		Acc += Mix16(Input + Length - 16, 136 - 17);
+		return Avalanche(Acc);
+	}
+	else if( Length > 16 )
+	{
+		std::uint64_t Acc = Length * Prime64_1;
+		if( Length > 32 )
+		{
+			if( Length > 64 )
+			{
+				if( Length > 96 )
+				{
+					Acc += Mix16(Input + 48, 96);
+					Acc += Mix16(Input + Length - 64, 112);
+				}
+				Acc += Mix16(Input + 32, 64);
+				Acc += Mix16(Input + Length - 48, 80);
+			}
+			Acc += Mix16(Input + 16, 32);
+			Acc += Mix16(Input + Length - 32, 48);
+		}
+		Acc += Mix16(Input + 0, 0);
+		Acc += Mix16(Input + Length - 16, 16);
+		return Avalanche(Acc);
+	}
+	else if( Length > 8 )
+	{
+		const std::uint64_t InputLow
+			= Read64(Input) ^ (SecretRead64(24) ^ SecretRead64(32));
+		const std::uint64_t InputHigh = Read64(Input + Length - 8)
+									  ^ (SecretRead64(40) ^ SecretRead64(48));
+		const std::uint64_t Acc = Length + __builtin_bswap64(InputLow)
+								+ InputHigh
+								+ Multiply128Fold64(InputLow, InputHigh);
+		return Avalanche(Acc);
+	}
+	else if( Length >= 4 )
+	{
+		const std::uint64_t Input64
+			= Read32(Input + Length - 4)
+			+ (std::uint64_t(Read32(Input)) << 32);
+		return RRMXMX(
+			Input64 ^ (SecretRead64(8) ^ SecretRead64(16)), Length);
+	}
+	else if( Length > 0 )
+	{
+		const std::uint32_t Combined
+			= (std::uint32_t(Input[0]) << 16)
+			| (std::uint32_t(Input[Length >> 1]) << 24)
+			| (std::uint32_t(Input[Length - 1]) << 0)
+			| (std::uint32_t(Length) << 8);
+		return XXH64Avalanche(
+			Combined ^ std::uint64_t(SecretRead32(0) ^ SecretRead32(4)));
+	}
+	return XXH64Avalanche(SecretRead64(56) ^ SecretRead64(64));
+}
+
+static Digest128 Hash128Finish(Digest128 Acc, std::uint64_t Length)
+{
+	const std::uint64_t Low  = Acc.Low + Acc.High;
+	const std::uint64_t High = Acc.Low * Prime64_1 + Acc.High * Prime64_4
+							 + Length * Prime64_2;
+	return {Avalanche(Low), 0 - Avalanche(High)};
+}
+
+static Digest128 Hash128Short(std::span<const std::byte> Data)
+{
+	const std::byte*    Input  = Data.data();
+	const std::uint64_t Length = Data.size();
+
+	if( Length > 128 )
+	{
+		Digest128 Acc = {Length * Prime64_1, 0};
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			Mix32(Acc, Input + i * 32, Input + i * 32 + 16, i * 32);
+		}
+		Acc.Low  = Avalanche(Acc.Low);
+		Acc.High = Avalanche(Acc.High);
+
+		for( std::size_t i = 4; i < Length / 32; ++i )
+		{
+			Mix32(
+				Acc, Input + i * 32, Input + i * 32 + 16, (i - 4) * 32 + 3);
+		}
+		Mix32(Acc, Input + Length - 16, Input + Length - 32, 136 - 17 - 16);
+		return Hash128Finish(Acc, Length);
+	}
+	else if( Length > 16 )
+	{
+		Digest128 Acc = {Length * Prime64_1, 0};
+		if( Length > 32 )
+		{
+			if( Length > 64 )
+			{
+				if( Length > 96 )
+				{
+					Mix32(Acc, Input + 48, Input + Length - 64, 96);
+				}
+				Mix32(Acc, Input + 32, Input + Length - 48, 64);
+			}
+			Mix32(Acc, Input + 16, Input + Length - 32, 32);
+		}
+		Mix32(Acc, Input, Input + Length - 16, 0);
+		return Hash128Finish(Acc, Length);
+	}
+	else if( Length > 8 )
+	{
+		const std::uint64_t BitFlipLow  = SecretRead64(32) ^ SecretRead64(40);
+		const std::uint64_t BitFlipHigh = SecretRead64(48) ^ SecretRead64(56);
+		const std::uint64_t InputLow    = Read64(Input);
+		const std::uint64_t InputHigh
+			= Read64(Input + Length - 8) ^ BitFlipHigh;
+
+		Digest128 Mul = Multiply64To128(
+			InputLow ^ Read64(Input + Length - 8) ^ BitFlipLow, Prime64_1);
+		Mul.Low += (Length - 1) << 54;
+		Mul.High += InputHigh
+				  + std::uint64_t(std::uint32_t(InputHigh)) * (Prime32_2 - 1);
+		Mul.Low ^= __builtin_bswap64(Mul.High);
+
+		Digest128 Hash = Multiply64To128(Mul.Low, Prime64_2);
+		Hash.High += Mul.High * Prime64_2;
+		return {Avalanche(Hash.Low), Avalanche(Hash.High)};
+	}
+	else if( Length >= 4 )
+	{
+		const std::uint64_t Input64
+			= Read32(Input) + (std::uint64_t(Read32(Input + Length - 4)) << 32);
+		const std::uint64_t Keyed
+			= Input64 ^ (SecretRead64(16) ^ SecretRead64(24));
+
+		Digest128 Mul = Multiply64To128(Keyed, Prime64_1 + (Length << 2));
+		Mul.High += Mul.Low << 1;
+		Mul.Low ^= Mul.High >> 3;
+		Mul.Low ^= Mul.Low >> 35;
+		Mul.Low *= PrimeMx2;
+		Mul.Low ^= Mul.Low >> 28;
+		return {Mul.Low, Avalanche(Mul.High)};
+	}
+	else if( Length > 0 )
+	{
+		const std::uint32_t CombinedLow
+			= (std::uint32_t(Input[0]) << 16)
+			| (std::uint32_t(Input[Length >> 1]) << 24)
+			| (std::uint32_t(Input[Length - 1]) << 0)
+			| (std::uint32_t(Length) << 8);
+		const std::uint32_t CombinedHigh
+			= std::rotl(__builtin_bswap32(CombinedLow), 13);
+		return {
+			XXH64Avalanche(
+				CombinedLow ^ std::uint64_t(SecretRead32(0) ^ SecretRead32(4))),
+			XXH64Avalanche(
+				CombinedHigh
+				^ std::uint64_t(SecretRead32(8) ^ SecretRead32(12)))};
+	}
+	return {
+		XXH64Avalanche(SecretRead64(64) ^ SecretRead64(72)),
+		XXH64Avalanche(SecretRead64(80) ^ SecretRead64(88))};
+}
+
+std::uint64_t Hash64(std::span<const std::byte> Data)
+{
+	if( Data.size() <= MidSizeMax )
+	{
+		return Hash64Short(Data);
+	}
+
+	alignas(64) std::array<std::uint64_t, 8> Acc = AccInit;
+	AccumulateLong(Acc, Data);
+	return MergeAccs64(Acc, Data.size());
+}
+
+Digest128 Hash128(std::span<const std::byte> Data)
+{
+	if( Data.size() <= MidSizeMax )
+	{
+		return Hash128Short(Data);
+	}
+
+	alignas(64) std::array<std::uint64_t, 8> Acc = AccInit;
+	AccumulateLong(Acc, Data);
+	return MergeAccs128(Acc, Data.size());
+}
+
+Hasher::Hasher() : Acc(AccInit)
+{
+}
+
+void Hasher::Update(std::span<const std::byte> Data)
+{
+	TotalLength += Data.size();
+
+	if( BufferSize + Data.size() <= Buffer.size() )
+	{
+		std::copy(Data.begin(), Data.end(), Buffer.begin() + BufferSize);
+		BufferSize += Data.size();
+		return;
+	}
+
+	const AccumulateT Accumulate = GetAccumulate();
+
+	// Top off the buffer and accumulate all of it. There is always more input
+	// after it.
+	if( BufferSize )
+	{
+		const std::size_t LoadSize = Buffer.size() - BufferSize;
+		std::copy_n(Data.begin(), LoadSize, Buffer.begin() + BufferSize);
+		Data = Data.subspan(LoadSize);
+
+		StripeIndex = Accumulate(
+			Acc, StripeIndex, Buffer.data(), Buffer.size() / StripeSize);
+		BufferSize = 0;
+	}
+
+	// Accumulate directly from the input, holding back at least one byte so
+	// that the last stripe is only ever accumulated upon finalizing
+	if( Data.size() > StripeSize )
+	{
+		const std::size_t StripeCount = (Data.size() - 1) / StripeSize;
+		StripeIndex = Accumulate(Acc, StripeIndex, Data.data(), StripeCount);
+		Data        = Data.subspan(StripeCount * StripeSize);
+
+		std::copy_n(
+			Data.data() - StripeSize, StripeSize,
+			Buffer.end() - StripeSize);
+	}
+
+	std::copy(Data.begin(), Data.end(), Buffer.begin());
+	BufferSize = Data.size();
+}
+
+// Accumulates whatever input remains buffered, along with the last stripe,
+// into a copy of the lanes
+static void AccumulateFinal(
+	std::span<std::uint64_t, 8> Acc, std::size_t StripeIndex,
+	std::span<const std::byte, 256> Buffer, std::size_t BufferSize)
+{
+	if( BufferSize >= StripeSize )
+	{
+		GetAccumulate()(
+			Acc, StripeIndex, Buffer.data(), (BufferSize - 1) / StripeSize);
+		AccumulateLastStripe(Acc, Buffer.data() + BufferSize - StripeSize);
+	}
+	else
+	{
+		// The last stripe begins within the last stripe accumulated
+		std::array<std::byte, StripeSize> LastStripe;
+		const std::size_t CatchUpSize = StripeSize - BufferSize;
+		std::copy_n(
+			Buffer.end() - CatchUpSize, CatchUpSize, LastStripe.begin());
+		std::copy_n(
+			Buffer.begin(), BufferSize, LastStripe.begin() + CatchUpSize);
+		AccumulateLastStripe(Acc, LastStripe.data());
+	}
+}
+
+std::uint64_t Hasher::Finalize64() const
+{
+	if( TotalLength <= MidSizeMax )
+	{
+		return Hash64Short(std::span(Buffer).first(TotalLength));
+	}
+
+	alignas(64) std::array<std::uint64_t, 8> FinalAcc = Acc;
+	AccumulateFinal(FinalAcc, StripeIndex, Buffer, BufferSize);
+	return MergeAccs64(FinalAcc, TotalLength);
+}
+
+Digest128 Hasher::Finalize128() const
+{
+	if( TotalLength <= MidSizeMax )
+	{
+		return Hash128Short(std::span(Buffer).first(TotalLength));
+	}
+
+	alignas(64) std::array<std::uint64_t, 8> FinalAcc = Acc;
+	AccumulateFinal(FinalAcc, StripeIndex, Buffer, BufferSize);
+	return MergeAccs128(FinalAcc, TotalLength);
+}
+
+} // namespace XXH
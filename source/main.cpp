@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <charconv>
 #include <cstring>
+#include <string_view>
 #include <thread>
 
 #include <sys/stat.h>
@@ -8,8 +9,28 @@
 
 #include <CRC/CRC32.hpp>
 
+#include <IOUring.hpp>
 #include <qCheck.hpp>
 
+static constexpr std::pair<const char*, CRC::Polynomial> PolynomialNames[] = {
+	{"crc32", CRC::Polynomial::CRC32},   {"crc32c", CRC::Polynomial::CRC32C},
+	{"crc32k", CRC::Polynomial::CRC32K}, {"crc32k2", CRC::Polynomial::CRC32K2},
+	{"crc32q", CRC::Polynomial::CRC32Q},
+};
+
+static constexpr std::pair<const char*, IOMethod> IOMethodNames[] = {
+	{"mmap", IOMethod::MMap},
+	{"uring", IOMethod::IOUring},
+};
+
+static constexpr std::pair<const char*, HashAlgorithm> AlgorithmNames[] = {
+	{"crc", HashAlgorithm::CRC},
+	{"xxh3", HashAlgorithm::XXH3},
+	{"xxh128", HashAlgorithm::XXH128},
+	{"sha256", HashAlgorithm::SHA256},
+	{"md5", HashAlgorithm::MD5},
+};
+
 int main(int argc, char* argv[])
 {
 	Settings CurSettings = {};
@@ -24,7 +45,8 @@ int main(int argc, char* argv[])
 		return EXIT_SUCCESS;
 	}
 	// Parse Arguments
-	while( (Opt = getopt_long(argc, argv, "t:ch", CommandOptions, &OptionIndex))
+	while( (Opt = getopt_long(
+				argc, argv, "t:cp:a:o:i:dsCh", CommandOptions, &OptionIndex))
 		   != -1 )
 	{
 		switch( Opt )
@@ -47,6 +69,98 @@ int main(int argc, char* argv[])
 			CurSettings.Check = true;
 			break;
 		}
+		case 'p':
+		{
+			const auto PolynomialName = std::find_if(
+				std::begin(PolynomialNames), std::end(PolynomialNames),
+				[](const auto& Entry) -> bool {
+					return std::strcmp(Entry.first, optarg) == 0;
+				});
+			if( PolynomialName == std::end(PolynomialNames) )
+			{
+				std::fprintf(stdout, "Invalid polynomial \"%s\"\n", optarg);
+				return EXIT_FAILURE;
+			}
+			CurSettings.Polynomial = PolynomialName->second;
+			break;
+		}
+		case 'a':
+		{
+			// A comma-separated list of algorithms, all of which are computed
+			// from the same read of each file
+			std::vector<HashAlgorithm>& Algorithms = CurSettings.Algorithms;
+			Algorithms.clear();
+
+			std::string_view Names(optarg);
+			while( true )
+			{
+				const std::size_t      CommaPos = Names.find(',');
+				const std::string_view CurName  = Names.substr(0, CommaPos);
+
+				const auto AlgorithmName = std::find_if(
+					std::begin(AlgorithmNames), std::end(AlgorithmNames),
+					[CurName](const auto& Entry) -> bool {
+						return CurName == Entry.first;
+					});
+				if( AlgorithmName == std::end(AlgorithmNames) )
+				{
+					std::fprintf(
+						stdout, "Invalid algorithm \"%.*s\"\n",
+						int(CurName.size()), CurName.data());
+					return EXIT_FAILURE;
+				}
+
+				if( std::find(
+						Algorithms.begin(), Algorithms.end(),
+						AlgorithmName->second)
+					== Algorithms.end() )
+				{
+					Algorithms.push_back(AlgorithmName->second);
+				}
+
+				if( CommaPos == std::string_view::npos )
+				{
+					break;
+				}
+				Names.remove_prefix(CommaPos + 1);
+			}
+			break;
+		}
+		case 'o':
+		{
+			CurSettings.OutputPrefix = optarg;
+			break;
+		}
+		case 'i':
+		{
+			const auto IOMethodName = std::find_if(
+				std::begin(IOMethodNames), std::end(IOMethodNames),
+				[](const auto& Entry) -> bool {
+					return std::strcmp(Entry.first, optarg) == 0;
+				});
+			if( IOMethodName == std::end(IOMethodNames) )
+			{
+				std::fprintf(stdout, "Invalid IO method \"%s\"\n", optarg);
+				return EXIT_FAILURE;
+			}
+			CurSettings.IO = IOMethodName->second;
+			break;
+		}
+		case 'd':
+		{
+			CurSettings.Direct = true;
+			break;
+		}
+		case 's':
+		{
+			CurSettings.Scrub = true;
+			break;
+		}
+		case 'C':
+		{
+			CurSettings.Calibrate = true;
+			break;
+		}
 		case 'h':
 		default:
 		{
@@ -60,6 +174,19 @@ int main(int argc, char* argv[])
 
 	// Check for config errors here
 
+	if( CurSettings.IO == IOMethod::IOUring && !IOUring::Create(1) )
+	{
+		std::fprintf(
+			stderr, "io_uring is unavailable, mapping files instead\n");
+		CurSettings.IO = IOMethod::MMap;
+	}
+
+	LoadCRCProfile(CurSettings);
+	if( CurSettings.Calibrate && argc == 0 )
+	{
+		return EXIT_SUCCESS;
+	}
+
 	for( std::intmax_t i = 0; i < argc; ++i )
 	{
 		const std::filesystem::path CurPath(argv[i]);
@@ -69,9 +196,10 @@ int main(int argc, char* argv[])
 			continue;
 		}
 		std::error_code CurError;
-		// Regular files only, for now, other files will be specially handled
-		// later
-		if( std::filesystem::is_regular_file(CurPath, CurError) )
+		// Pipes, and other streams, are read until their end
+		if( std::filesystem::is_regular_file(CurPath, CurError)
+			|| std::filesystem::is_fifo(CurPath, CurError)
+			|| std::filesystem::is_character_file(CurPath, CurError) )
 		{
 			CurSettings.InputFiles.emplace_back(CurPath);
 		}
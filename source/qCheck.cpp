@@ -1,11 +1,24 @@
 #include <qCheck.hpp>
 
+#include <algorithm>
+#include <cerrno>
 #include <charconv>
+#include <condition_variable>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <span>
 #include <thread>
+#include <unordered_map>
+#include <variant>
 
 #include <CRC/CRC32.hpp>
+#include <IOUring.hpp>
+#include <MD5/MD5.hpp>
+#include <SHA/SHA256.hpp>
+#include <XXH/XXH3.hpp>
 
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -16,74 +29,1687 @@ const char* Usage
 	= "qCheck - Wunkolo <wunkolo@gmail.com>\n"
 	  "Usage: qCheck [Options]... [Files]...\n"
 	  "  -t, --threads            Number of checker threads in parallel\n"
-	  "  -c, --check              Verify all input as .sfv files\n"
+	  "  -c, --check              Verify all input as checksum files\n"
+	  "  -p, --polynomial         CRC polynomial to generate and verify with\n"
+	  "                           crc32(default), crc32c, crc32k, crc32k2,\n"
+	  "                           crc32q\n"
+	  "  -a, --algorithm          Checksum algorithms to generate with, by\n"
+	  "                           commas, all from one read of each file\n"
+	  "                           crc(default, .sfv), xxh3, xxh128, sha256,\n"
+	  "                           md5\n"
+	  "  -o, --output             Write the manifest of each algorithm to\n"
+	  "                           its own file, <output>.sfv, <output>.md5,\n"
+	  "                           and so on, rather than all to stdout\n"
+	  "  -i, --io                 How to read files in\n"
+	  "                           mmap(default), uring\n"
+	  "  -d, --direct             Read around the page cache, so as not to\n"
+	  "                           evict whatever else is cached\n"
+	  "  -s, --scrub              Drop whatever was read from the page cache\n"
+	  "                           once hashed, unless it was cached already\n"
+	  "  -C, --calibrate          Measure the CRC kernels of this machine and\n"
+	  "                           cache the fastest for each input size\n"
 	  "  -h, --help               Show this help message\n";
 
-static std::optional<std::uint32_t>
-	ChecksumFile(const std::filesystem::path& Path)
+// Files larger than this are split into ranges that are hashed in parallel by
+// separate workers, and then merged back together with CRC::Combine
+static constexpr std::uint64_t FileRangeSize = 64ull * 1024 * 1024;
+
+// The checksum of a file, as the bytes of its canonical big-endian form. Wide
+// enough for any of the supported algorithms.
+using Digest = std::array<std::uint8_t, 32>;
+
+// The checksums of the same data with each of several algorithms, in the same
+// order as the algorithms
+using DigestList = std::vector<Digest>;
+
+static std::size_t DigestSize(HashAlgorithm Algorithm)
+{
+	switch( Algorithm )
+	{
+	default:
+	case HashAlgorithm::CRC:
+		return 4;
+	case HashAlgorithm::XXH3:
+		return 8;
+	case HashAlgorithm::XXH128:
+		return 16;
+	case HashAlgorithm::SHA256:
+		return 32;
+	case HashAlgorithm::MD5:
+		return 16;
+	}
+}
+
+static const char* AlgorithmTag(HashAlgorithm Algorithm)
+{
+	switch( Algorithm )
+	{
+	default:
+	case HashAlgorithm::CRC:
+		return "CRC32";
+	case HashAlgorithm::XXH3:
+		return "XXH3";
+	case HashAlgorithm::XXH128:
+		return "XXH128";
+	case HashAlgorithm::SHA256:
+		return "SHA256";
+	case HashAlgorithm::MD5:
+		return "MD5";
+	}
+}
+
+// Extension of the manifest files of each algorithm
+static const char* AlgorithmExtension(HashAlgorithm Algorithm)
+{
+	switch( Algorithm )
+	{
+	default:
+	case HashAlgorithm::CRC:
+		return "sfv";
+	case HashAlgorithm::XXH3:
+		return "xxh3";
+	case HashAlgorithm::XXH128:
+		return "xxh128";
+	case HashAlgorithm::SHA256:
+		return "sha256";
+	case HashAlgorithm::MD5:
+		return "md5";
+	}
+}
+
+// Only CRC checksums may be computed a range at a time and combined together
+// afterwards, and only CRC checksums skip over the holes of sparse files
+static bool IsCRCOnly(std::span<const HashAlgorithm> Algorithms)
+{
+	return Algorithms.size() == 1 && Algorithms[0] == HashAlgorithm::CRC;
+}
+
+// Writes Value into all of Bytes, most significant byte first
+static void StoreBigEndian(std::span<std::uint8_t> Bytes, std::uint64_t Value)
+{
+	for( auto CurByte = Bytes.rbegin(); CurByte != Bytes.rend(); ++CurByte )
+	{
+		*CurByte = std::uint8_t(Value);
+		Value >>= 8;
+	}
+}
+
+static Digest ToDigest(std::uint32_t CRC32)
+{
+	Digest Result = {};
+	StoreBigEndian(std::span(Result).first(4), CRC32);
+	return Result;
+}
+
+static Digest ToDigest(std::uint64_t Hash)
+{
+	Digest Result = {};
+	StoreBigEndian(std::span(Result).first(8), Hash);
+	return Result;
+}
+
+static Digest ToDigest(XXH::Digest128 Hash)
+{
+	Digest Result = {};
+	StoreBigEndian(std::span(Result).first(8), Hash.High);
+	StoreBigEndian(std::span(Result).subspan(8, 8), Hash.Low);
+	return Result;
+}
+
+// Digests that are already a string of bytes, such as those of SHA-256 and MD5
+template<std::size_t N>
+static Digest ToDigest(const std::array<std::uint8_t, N>& Hash)
+{
+	Digest Result = {};
+	std::copy(Hash.begin(), Hash.end(), Result.begin());
+	return Result;
+}
+
+static std::uint32_t DigestCRC32(const Digest& Checksum)
+{
+	return (std::uint32_t(Checksum[0]) << 24)
+		 | (std::uint32_t(Checksum[1]) << 16)
+		 | (std::uint32_t(Checksum[2]) << 8)
+		 | (std::uint32_t(Checksum[3]) << 0);
+}
+
+// Formats a checksum as hexadecimal. Upper-case for .sfv files, and lower-case
+// for everything else, as is the convention of each.
+static std::string FormatDigest(const Digest& Checksum, HashAlgorithm Algorithm)
+{
+	const char* Digits = Algorithm == HashAlgorithm::CRC ? "0123456789ABCDEF"
+														 : "0123456789abcdef";
+	std::string Result;
+	for( const std::uint8_t CurByte :
+		 std::span(Checksum).first(DigestSize(Algorithm)) )
+	{
+		Result.push_back(Digits[CurByte >> 4]);
+		Result.push_back(Digits[CurByte & 0xF]);
+	}
+	return Result;
+}
+
+// Parses the hexadecimal string of a checksum of the given algorithm
+static std::optional<Digest>
+	ParseDigest(std::string_view String, HashAlgorithm Algorithm)
+{
+	if( String.size() != DigestSize(Algorithm) * 2 )
+	{
+		return std::nullopt;
+	}
+
+	Digest Checksum = {};
+	for( std::size_t i = 0; i < String.size() / 2; ++i )
+	{
+		const std::from_chars_result ParseResult = std::from_chars(
+			String.data() + i * 2, String.data() + i * 2 + 2, Checksum[i], 16);
+		if( ParseResult.ec != std::errc()
+			|| ParseResult.ptr != String.data() + i * 2 + 2 )
+		{
+			return std::nullopt;
+		}
+	}
+	return Checksum;
+}
+
+// Hashes data that is entirely in memory
+static Digest HashData(
+	std::span<const std::byte> Data, HashAlgorithm Algorithm,
+	CRC::Polynomial Poly)
+{
+	switch( Algorithm )
+	{
+	default:
+	case HashAlgorithm::CRC:
+		return ToDigest(CRC::Checksum(Data, 0, Poly));
+	case HashAlgorithm::XXH3:
+		return ToDigest(XXH::Hash64(Data));
+	case HashAlgorithm::XXH128:
+		return ToDigest(XXH::Hash128(Data));
+	case HashAlgorithm::SHA256:
+		return ToDigest(SHA::Hash256(Data));
+	case HashAlgorithm::MD5:
+		return ToDigest(MD5::Hash(Data));
+	}
+}
+
+// Reads that each worker's io_uring keeps in flight at once, and the size of
+// each. Enough to keep several NVMe drives busy with just a few workers.
+static constexpr unsigned    RingQueueDepth = 16;
+static constexpr std::size_t RingReadSize   = 256 * 1024;
+
+// Each worker reads into a single pool of buffers, allocated once. Without
+// io_uring, the pool is read into a half at a time.
+static constexpr std::size_t BufferPoolSize = RingQueueDepth * RingReadSize;
+static constexpr std::size_t ReadBufferSize = BufferPoolSize / 2;
+
+// Direct reads must start upon, and span, whole blocks of the device, which
+// are never larger than a page
+static constexpr std::size_t DirectAlignment = 4096;
+
+static constexpr std::uint64_t AlignUp(std::uint64_t Value, std::uint64_t Align)
+{
+	return (Value + Align - 1) / Align * Align;
+}
+
+struct BufferPoolDelete
+{
+	void operator()(std::byte* Memory) const
+	{
+		munmap(Memory, BufferPoolSize);
+	}
+};
+
+// Backed by huge pages where possible, so that each read pins fewer pages and
+// takes fewer TLB entries
+static std::byte* AllocateBufferPool()
+{
+	void* Memory = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+	// Only succeeds if the administrator has reserved huge pages
+	Memory = mmap(
+		nullptr, BufferPoolSize, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+	if( Memory == MAP_FAILED )
+	{
+		Memory = mmap(
+			nullptr, BufferPoolSize, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if( Memory == MAP_FAILED )
+		{
+			return nullptr;
+		}
+#if defined(MADV_HUGEPAGE)
+		madvise(Memory, BufferPoolSize, MADV_HUGEPAGE);
+#endif
+	}
+	return static_cast<std::byte*>(Memory);
+}
+
+// Reads into Data at Offset of an open file until at least Size bytes have
+// been read. Direct reads of the last block of a file may go past its end.
+static bool ReadFully(
+	int FileHandle, std::span<std::byte> Data, std::uint64_t Offset,
+	std::size_t Size)
+{
+	for( std::size_t ReadCount = 0; ReadCount < Size; )
+	{
+		const ssize_t CurReadCount = pread(
+			FileHandle, Data.data() + ReadCount, Data.size() - ReadCount,
+			Offset + ReadCount);
+		if( CurReadCount <= 0 )
+		{
+			return false;
+		}
+		ReadCount += CurReadCount;
+	}
+	return true;
+}
+
+// Reads into Data from wherever a stream, such as a pipe, is at, until either
+// Data is full or the stream ends. Returns how many bytes were read, or nothing
+// upon failure.
+static std::optional<std::size_t>
+	ReadStream(int FileHandle, std::span<std::byte> Data)
+{
+	std::size_t ReadCount = 0;
+	while( ReadCount < Data.size() )
+	{
+		const ssize_t CurReadCount = read(
+			FileHandle, Data.data() + ReadCount, Data.size() - ReadCount);
+		if( CurReadCount == 0 )
+		{
+			break;
+		}
+		if( CurReadCount < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			return std::nullopt;
+		}
+		ReadCount += CurReadCount;
+	}
+	return ReadCount;
+}
+
+// Reads into one buffer upon a thread of its own, while the worker that
+// started the read hashes another. Only one read is ever in flight.
+class ReadAheadThread
+{
+public:
+	ReadAheadThread() : Thread(&ReadAheadThread::Run, this)
+	{
+	}
+
+	~ReadAheadThread()
+	{
+		{
+			const std::lock_guard Lock(Mutex);
+			Stopping = true;
+		}
+		Condition.notify_all();
+		Thread.join();
+	}
+
+	ReadAheadThread(const ReadAheadThread&)            = delete;
+	ReadAheadThread& operator=(const ReadAheadThread&) = delete;
+
+	// Starts reading into Data, as with ReadFully. The last read must have
+	// been waited upon.
+	void Start(
+		int FileHandle, std::span<std::byte> Data, std::uint64_t Offset,
+		std::size_t Size)
+	{
+		{
+			const std::lock_guard Lock(Mutex);
+			Request = {FileHandle, Data, Offset, Size, false};
+			Pending = true;
+		}
+		Condition.notify_all();
+	}
+
+	// Starts reading into Data from a stream, as with ReadStream
+	void StartStream(int FileHandle, std::span<std::byte> Data)
+	{
+		{
+			const std::lock_guard Lock(Mutex);
+			Request = {FileHandle, Data, 0, Data.size(), true};
+			Pending = true;
+		}
+		Condition.notify_all();
+	}
+
+	// Waits for the last read to finish, and returns how many bytes it read,
+	// or nothing if it failed
+	std::optional<std::size_t> Wait()
+	{
+		std::unique_lock Lock(Mutex);
+		Condition.wait(Lock, [this] { return !Pending; });
+		return ReadCount;
+	}
+
+private:
+	void Run()
+	{
+		std::unique_lock Lock(Mutex);
+		while( true )
+		{
+			Condition.wait(Lock, [this] { return Pending || Stopping; });
+			if( Stopping )
+			{
+				return;
+			}
+
+			const ReadRequest CurRequest = Request;
+			Lock.unlock();
+			std::optional<std::size_t> Result;
+			if( CurRequest.Stream )
+			{
+				Result = ReadStream(CurRequest.FileHandle, CurRequest.Data);
+			}
+			else if( ReadFully(
+						 CurRequest.FileHandle, CurRequest.Data,
+						 CurRequest.Offset, CurRequest.Size) )
+			{
+				Result = CurRequest.Size;
+			}
+			Lock.lock();
+
+			ReadCount = Result;
+			Pending   = false;
+			Condition.notify_all();
+		}
+	}
+
+	struct ReadRequest
+	{
+		int                  FileHandle;
+		std::span<std::byte> Data;
+		std::uint64_t        Offset;
+		std::size_t          Size;
+		// Read in order from wherever the file is at, rather than from Offset
+		bool Stream;
+	};
+
+	std::mutex                 Mutex;
+	std::condition_variable    Condition;
+	ReadRequest                Request   = {};
+	bool                       Pending   = false;
+	std::optional<std::size_t> ReadCount = std::nullopt;
+	bool                       Stopping  = false;
+
+	// Started last, once everything it uses has been constructed
+	std::thread Thread;
+};
+
+// Reads in files for a single worker, with whichever IOMethod was selected
+class FileReader
+{
+public:
+	FileReader(IOMethod Method, bool DirectIO, bool ScrubCache)
+		: Direct(DirectIO), Scrub(ScrubCache)
+	{
+		// Falls back to mapping files if there is no io_uring
+		if( Method == IOMethod::IOUring )
+		{
+			Ring = IOUring::Create(RingQueueDepth);
+		}
+
+		if( !Ring && !Direct )
+		{
+			return;
+		}
+
+		BufferPool.reset(AllocateBufferPool());
+		if( !BufferPool )
+		{
+			Ring.reset();
+			Direct = false;
+			return;
+		}
+
+		if( Ring )
+		{
+			std::array<std::span<std::byte>, RingQueueDepth> Buffers;
+			for( std::size_t i = 0; i < Buffers.size(); ++i )
+			{
+				Buffers[i] = RingBuffer(i);
+			}
+			Ring->RegisterBuffers(Buffers);
+		}
+	}
+
+	// Opens a file to be read, around the page cache if reading directly.
+	// File systems that reject direct IO have their files read as usual.
+	int Open(const std::filesystem::path& Path) const
+	{
+#if defined(POSIX_FADV_RANDOM)
+		// Keeps the kernel from reading ahead past the range that was
+		// recorded, where nothing would drop what it read
+		if( IsScrubbing() )
+		{
+			const int FileHandle = open(Path.c_str(), O_RDONLY, 0);
+			if( FileHandle != -1 )
+			{
+				posix_fadvise(FileHandle, 0, 0, POSIX_FADV_RANDOM);
+			}
+			return FileHandle;
+		}
+#endif
+		if( Direct )
+		{
+#if defined(O_DIRECT)
+			const int FileHandle = open(Path.c_str(), O_RDONLY | O_DIRECT, 0);
+			if( FileHandle != -1 || errno != EINVAL )
+			{
+				return FileHandle;
+			}
+#elif defined(F_NOCACHE)
+			const int FileHandle = open(Path.c_str(), O_RDONLY, 0);
+			if( FileHandle != -1 )
+			{
+				fcntl(FileHandle, F_NOCACHE, 1);
+			}
+			return FileHandle;
+#endif
+		}
+		return open(Path.c_str(), O_RDONLY, 0);
+	}
+
+	// Null unless reading with io_uring, and once the ring has been left with
+	// reads in flight that it cannot wait upon, so that no later file is read
+	// through it
+	IOUring* GetRing() const
+	{
+		return Ring && !Ring->IsFailed() ? Ring.get() : nullptr;
+	}
+
+	bool IsDirect() const
+	{
+		return Direct;
+	}
+
+	// Reading directly leaves nothing in the page cache to begin with
+	bool IsScrubbing() const
+	{
+		return Scrub && !Direct;
+	}
+
+	// What the offset and size of each read must be a multiple of
+	std::size_t ReadAlignment() const
+	{
+		return Direct ? DirectAlignment : 1;
+	}
+
+	std::span<std::byte> GetBufferPool() const
+	{
+		return {BufferPool.get(), BufferPoolSize};
+	}
+
+	std::span<std::byte> RingBuffer(std::size_t Index) const
+	{
+		return GetBufferPool().subspan(Index * RingReadSize, RingReadSize);
+	}
+
+	std::span<std::byte> ReadBuffer(std::size_t Index) const
+	{
+		return GetBufferPool().subspan(Index * ReadBufferSize, ReadBufferSize);
+	}
+
+	// Only started, along with the buffer pool if need be, once a file has to
+	// be read without io_uring, which few ever are unless reading directly.
+	// Null upon failure.
+	ReadAheadThread* GetReadAhead() const
+	{
+		if( !BufferPool )
+		{
+			BufferPool.reset(AllocateBufferPool());
+			if( !BufferPool )
+			{
+				return nullptr;
+			}
+		}
+		if( !ReadAhead )
+		{
+			ReadAhead = std::make_unique<ReadAheadThread>();
+		}
+		return ReadAhead.get();
+	}
+
+private:
+	std::unique_ptr<IOUring> Ring;
+
+	// Allocated lazily by GetReadAhead
+	mutable std::unique_ptr<std::byte[], BufferPoolDelete> BufferPool;
+	mutable std::unique_ptr<ReadAheadThread>               ReadAhead;
+
+	bool Direct;
+	bool Scrub;
+};
+
+// Which pages of a range of a file were in the page cache before any of it was
+// read, so that the rest can be dropped from it again once hashed, leaving the
+// page cache as it was found. The whole range is recorded before reading, as
+// the kernel reads ahead past whatever was last read, even of files advised to
+// be read randomly once it has come upon pages that it read ahead for another
+// reader. Records nothing, and so drops nothing, upon failure.
+class PageResidency
+{
+public:
+	PageResidency() = default;
+
+	// Maps the range a piece at a time, just long enough to record it, along
+	// with whatever the kernel may read ahead past its end
+	PageResidency(int FileHandle, std::uint64_t Offset, std::uint64_t Length)
+		: Begin(Offset - Offset % PageSize()), End(Offset + Length),
+		  RecordEnd(End), Released(Begin)
+	{
+#if defined(POSIX_FADV_DONTNEED)
+		constexpr std::uint64_t PieceSize = 16ull * 1024 * 1024;
+
+		struct stat FileStat = {};
+		if( fstat(FileHandle, &FileStat) == 0 )
+		{
+			RecordEnd = std::clamp<std::uint64_t>(
+				FileStat.st_size, End, End + ReadAheadSlack);
+		}
+
+		std::vector<unsigned char> PieceResident;
+		for( std::uint64_t PieceOffset = Begin; PieceOffset < RecordEnd;
+			 PieceOffset += PieceSize )
+		{
+			const std::size_t MapSize
+				= std::min(PieceSize, RecordEnd - PieceOffset);
+
+			void* const Map = mmap(
+				nullptr, MapSize, PROT_READ, MAP_SHARED, FileHandle,
+				PieceOffset);
+			if( Map == MAP_FAILED )
+			{
+				Resident.clear();
+				return;
+			}
+			PieceResident.resize(AlignUp(MapSize, PageSize()) / PageSize());
+			const int Result = mincore(Map, MapSize, PieceResident.data());
+			munmap(Map, MapSize);
+			if( Result != 0 )
+			{
+				Resident.clear();
+				return;
+			}
+
+			for( const unsigned char CurPage : PieceResident )
+			{
+				Resident.push_back(CurPage & 1);
+			}
+		}
+#endif
+	}
+
+	// Drops the pages before ReleaseEnd that were not resident, and have not
+	// been dropped already, along with those past the end of the range once
+	// ReleaseEnd reaches it. Pages that are still mapped are not dropped, so
+	// they must have been unmapped by now.
+	void Release(int FileHandle, std::uint64_t ReleaseEnd)
+	{
+#if defined(POSIX_FADV_DONTNEED)
+		// The page cache holds runs of pages within folios that are only ever
+		// dropped whole, and that never cross a boundary of the largest of
+		// them. All but the end of the range are dropped up to one.
+		if( ReleaseEnd < End )
+		{
+			ReleaseEnd -= ReleaseEnd % MaxFolioSize;
+		}
+		else
+		{
+			ReleaseEnd = RecordEnd;
+		}
+		if( Resident.empty() || ReleaseEnd <= Released )
+		{
+			return;
+		}
+
+		const std::size_t FirstPage = (Released - Begin) / PageSize();
+		const std::size_t EndPage   = std::min<std::uint64_t>(
+			AlignUp(ReleaseEnd - Begin, PageSize()) / PageSize(),
+			Resident.size());
+		Released = ReleaseEnd;
+
+		for( std::size_t i = FirstPage; i < EndPage; )
+		{
+			if( Resident[i] )
+			{
+				++i;
+				continue;
+			}
+			std::size_t RunEnd = i;
+			while( RunEnd < EndPage && !Resident[RunEnd] )
+			{
+				++RunEnd;
+			}
+			posix_fadvise(
+				FileHandle, Begin + i * PageSize(), (RunEnd - i) * PageSize(),
+				POSIX_FADV_DONTNEED);
+			i = RunEnd;
+		}
+#endif
+	}
+
+private:
+	static std::uint64_t PageSize()
+	{
+		static const std::uint64_t Size = sysconf(_SC_PAGESIZE);
+		return Size;
+	}
+
+	// As large as a transparent huge page, on most systems
+	static constexpr std::uint64_t MaxFolioSize = 2ull * 1024 * 1024;
+
+	// The most that kernels have been seen to read ahead at once
+	static constexpr std::uint64_t ReadAheadSlack = 16ull * 1024 * 1024;
+
+	std::uint64_t Begin     = 0;
+	std::uint64_t End       = 0;
+	std::uint64_t RecordEnd = 0;
+	std::uint64_t Released  = 0;
+	// One bit for each page
+	std::vector<bool> Resident;
+};
+
+// Reads Length bytes of an open file starting at Offset into the buffers of
+// the ring, and hashes each buffer, in order, while the reads of the buffers
+// after it are still in flight. Each buffer is read into again as soon as it
+// has been hashed.
+template<typename HasherT>
+static bool HashFileRing(
+	const FileReader& Reader, int FileHandle, std::uint64_t Offset,
+	std::uint64_t Length, HasherT& Hasher, PageResidency& Residency)
+{
+	IOUring& Ring = *Reader.GetRing();
+
+	// Reads begin at the block that Offset is within, and the bytes before
+	// Offset are skipped over when hashing
+	const std::size_t   Alignment  = Reader.ReadAlignment();
+	const std::uint64_t ReadBegin  = Offset - Offset % Alignment;
+	const std::uint64_t ReadEnd    = Offset + Length;
+	const std::uint64_t ChunkCount = AlignUp(ReadEnd - ReadBegin, RingReadSize)
+								   / RingReadSize;
+
+	// Bytes of each chunk that must be read before it can be hashed
+	const auto ChunkSize = [&](std::uint64_t Chunk) -> std::size_t {
+		return std::min<std::uint64_t>(
+			RingReadSize, ReadEnd - ReadBegin - Chunk * RingReadSize);
+	};
+
+	// Bytes of the chunk within each buffer that have been read so far. Short
+	// reads are continued from wherever they left off.
+	std::array<std::size_t, RingQueueDepth> ReadSizes = {};
+
+	std::size_t InFlight = 0;
+
+	// Reads that fail still have to be waited upon before their buffers are
+	// free again
+	bool Failed = false;
+
+	const auto QueueChunk = [&](std::uint64_t Chunk) -> void {
+		const std::size_t Slot = Chunk % RingQueueDepth;
+
+		// Direct reads of the last block of a file may go past its end
+		const std::span<std::byte> ReadData
+			= Reader.RingBuffer(Slot)
+				  .first(AlignUp(ChunkSize(Chunk), Alignment))
+				  .subspan(ReadSizes[Slot]);
+		if( !Ring.QueueRead(
+				FileHandle, ReadData,
+				ReadBegin + Chunk * RingReadSize + ReadSizes[Slot], Chunk,
+				unsigned(Slot)) )
+		{
+			Failed = true;
+			return;
+		}
+		++InFlight;
+	};
+
+	std::uint64_t NextChunk = 0;
+	for( ; NextChunk < std::min<std::uint64_t>(RingQueueDepth, ChunkCount)
+		   && !Failed;
+		 ++NextChunk )
+	{
+		QueueChunk(NextChunk);
+	}
+
+	std::uint64_t                    HashChunk = 0;
+	std::array<bool, RingQueueDepth> Ready     = {};
+	while( InFlight )
+	{
+		const std::optional<IOUring::Completion> CurCompletion
+			= Ring.WaitCompletion();
+		if( !CurCompletion.has_value() )
+		{
+			// None of the buffers may be read into again until every read
+			// into them has completed, nor may their completions be taken
+			// for those of the next file
+			Ring.Drain();
+			return false;
+		}
+		--InFlight;
+
+		const std::uint64_t Chunk = CurCompletion->UserData;
+		const std::size_t   Slot  = Chunk % RingQueueDepth;
+		if( CurCompletion->Result <= 0 )
+		{
+			Failed = true;
+			continue;
+		}
+
+		ReadSizes[Slot] += CurCompletion->Result;
+		if( ReadSizes[Slot] < ChunkSize(Chunk) )
+		{
+			if( !Failed )
+			{
+				QueueChunk(Chunk);
+			}
+			continue;
+		}
+		Ready[Slot] = true;
+
+		while( !Failed && HashChunk < ChunkCount
+			   && Ready[HashChunk % RingQueueDepth] )
+		{
+			const std::size_t Skip = HashChunk ? 0 : Offset - ReadBegin;
+			Hasher.Update(Reader.RingBuffer(HashChunk % RingQueueDepth)
+							  .first(ChunkSize(HashChunk))
+							  .subspan(Skip));
+			Residency.Release(
+				FileHandle,
+				ReadBegin + HashChunk * RingReadSize + ChunkSize(HashChunk));
+			Ready[HashChunk % RingQueueDepth] = false;
+			++HashChunk;
+
+			if( NextChunk < ChunkCount && !Failed )
+			{
+				ReadSizes[NextChunk % RingQueueDepth] = 0;
+				QueueChunk(NextChunk++);
+				Ring.Submit();
+			}
+		}
+	}
+
+	return !Failed && HashChunk == ChunkCount;
+}
+
+// Reads Length bytes of an open file starting at Offset into each half of the
+// buffer pool in turn, and hashes each half while the read-ahead thread reads
+// into the other
+template<typename HasherT>
+static bool HashFileReads(
+	const FileReader& Reader, int FileHandle, std::uint64_t Offset,
+	std::uint64_t Length, HasherT& Hasher, PageResidency& Residency)
+{
+	if( !Length )
+	{
+		return true;
+	}
+
+	ReadAheadThread* const ReadAhead = Reader.GetReadAhead();
+	if( !ReadAhead )
+	{
+		return false;
+	}
+
+	// Reads begin at the block that Offset is within, and the bytes before
+	// Offset are skipped over when hashing
+	const std::size_t   Alignment = Reader.ReadAlignment();
+	const std::uint64_t ReadBegin = Offset - Offset % Alignment;
+	const std::uint64_t ReadEnd   = Offset + Length;
+
+	const auto ReadSize = [&](std::uint64_t ReadOffset) -> std::size_t {
+		return std::min<std::uint64_t>(ReadBufferSize, ReadEnd - ReadOffset);
+	};
+
+	const auto StartRead = [&](std::uint64_t ReadOffset, std::size_t Index) {
+		ReadAhead->Start(
+			FileHandle,
+			Reader.ReadBuffer(Index).first(
+				AlignUp(ReadSize(ReadOffset), Alignment)),
+			ReadOffset, ReadSize(ReadOffset));
+	};
+
+	StartRead(ReadBegin, 0);
+	for( std::uint64_t ReadOffset = ReadBegin, Index = 0; ReadOffset < ReadEnd;
+		 ReadOffset += ReadBufferSize, Index ^= 1 )
+	{
+		if( !ReadAhead->Wait() )
+		{
+			return false;
+		}
+
+		const std::uint64_t NextOffset = ReadOffset + ReadBufferSize;
+		if( NextOffset < ReadEnd )
+		{
+			StartRead(NextOffset, Index ^ 1);
+		}
+
+		const std::size_t Skip = std::max(Offset, ReadOffset) - ReadOffset;
+		Hasher.Update(
+			Reader.ReadBuffer(Index).first(ReadSize(ReadOffset)).subspan(Skip));
+		Residency.Release(FileHandle, ReadOffset + ReadSize(ReadOffset));
+	}
+	return true;
+}
+
+// Hashes all that is left of a stream, such as a pipe, which can only be read
+// in order and has no size to read up to. Each half of the buffer pool is
+// hashed while the read-ahead thread reads into the other, until a read comes
+// up short upon the end of the stream.
+template<typename HasherT>
+static bool
+	HashFileStream(const FileReader& Reader, int FileHandle, HasherT& Hasher)
+{
+	ReadAheadThread* const ReadAhead = Reader.GetReadAhead();
+	if( !ReadAhead )
+	{
+		return false;
+	}
+
+	ReadAhead->StartStream(FileHandle, Reader.ReadBuffer(0));
+	for( std::size_t Index = 0;; Index ^= 1 )
+	{
+		const std::optional<std::size_t> ReadCount = ReadAhead->Wait();
+		if( !ReadCount.has_value() )
+		{
+			return false;
+		}
+
+		const bool Ended = *ReadCount < ReadBufferSize;
+		if( !Ended )
+		{
+			ReadAhead->StartStream(FileHandle, Reader.ReadBuffer(Index ^ 1));
+		}
+
+		Hasher.Update(Reader.ReadBuffer(Index).first(*ReadCount));
+		if( Ended )
+		{
+			return true;
+		}
+	}
+}
+
+// Files are mapped a window at a time, rather than all at once. The next window
+// is read ahead while the current one is hashed, and each window is unmapped
+// once hashed, so that a worker never has more than two mapped.
+static constexpr std::uint64_t MapWindowSize = 16ull * 1024 * 1024;
+static constexpr std::size_t   ReadAheadSize = 1024 * 1024;
+
+// Hashes as much of Length bytes of an open file starting at Offset as can be
+// mapped, and returns how many bytes that was
+template<typename HasherT>
+static std::uint64_t HashFileMapped(
+	const FileReader& Reader, int FileHandle, std::uint64_t Offset,
+	std::uint64_t Length, HasherT& Hasher, PageResidency& Residency)
+{
+	// Mappings must start on a page boundary
+	static const std::uint64_t PageSize = sysconf(_SC_PAGESIZE);
+
+	const std::uint64_t EndOffset = Offset + Length;
+
+	// Maps the window at WindowOffset and starts reading it in, or returns an
+	// empty window upon failure
+	const auto MapWindow
+		= [&](std::uint64_t WindowOffset) -> std::span<const std::byte> {
+		const std::size_t WindowSize
+			= std::min(MapWindowSize, EndOffset - WindowOffset);
+		void* const WindowMap = mmap(
+			nullptr, WindowSize, PROT_READ, MAP_SHARED, FileHandle,
+			WindowOffset);
+		if( WindowMap == MAP_FAILED )
+		{
+			return {};
+		}
+		// Faults read in no more than the page faulted upon, rather than
+		// reading ahead past the end of the range
+		if( Reader.IsScrubbing() )
+		{
+			madvise(WindowMap, WindowSize, MADV_RANDOM);
+		}
+		// The kernel reads ahead no more than a little of each request
+		for( std::size_t i = 0; i < WindowSize; i += ReadAheadSize )
+		{
+			madvise(
+				static_cast<std::byte*>(WindowMap) + i,
+				std::min(ReadAheadSize, WindowSize - i), MADV_WILLNEED);
+		}
+		return {static_cast<const std::byte*>(WindowMap), WindowSize};
+	};
+
+	std::uint64_t              WindowOffset = Offset - Offset % PageSize;
+	std::span<const std::byte> Window;
+	if( Length )
+	{
+		Window = MapWindow(WindowOffset);
+	}
+
+	std::uint64_t MappedLength = 0;
+	while( !Window.empty() )
+	{
+		const std::uint64_t        NextOffset = WindowOffset + Window.size();
+		std::span<const std::byte> NextWindow;
+		if( NextOffset < EndOffset )
+		{
+			NextWindow = MapWindow(NextOffset);
+		}
+
+		const std::span<const std::byte> WindowData
+			= Window.subspan(std::max(Offset, WindowOffset) - WindowOffset);
+		Hasher.Update(WindowData);
+		MappedLength += WindowData.size();
+
+		munmap(const_cast<std::byte*>(Window.data()), Window.size());
+		Residency.Release(FileHandle, NextOffset);
+
+		WindowOffset = NextOffset;
+		Window       = NextWindow;
+	}
+	return MappedLength;
+}
+
+// Hashes Length bytes of an open file starting at Offset, carrying on from
+// whatever Hasher has been given before
+template<typename HasherT>
+static bool HashFileData(
+	const FileReader& Reader, int FileHandle, std::uint64_t Offset,
+	std::uint64_t Length, HasherT& Hasher)
+{
+	PageResidency Residency;
+	if( Reader.IsScrubbing() )
+	{
+		Residency = PageResidency(FileHandle, Offset, Length);
+	}
+
+	if( Reader.GetRing() )
+	{
+		return HashFileRing(
+			Reader, FileHandle, Offset, Length, Hasher, Residency);
+	}
+
+	// Mapped files are read through the page cache
+	if( Reader.IsDirect() )
+	{
+		return HashFileReads(
+			Reader, FileHandle, Offset, Length, Hasher, Residency);
+	}
+
+	// Whatever cannot be mapped is read instead
+	const std::uint64_t MappedLength = HashFileMapped(
+		Reader, FileHandle, Offset, Length, Hasher, Residency);
+	return HashFileReads(
+		Reader, FileHandle, Offset + MappedLength, Length - MappedLength,
+		Hasher, Residency);
+}
+
+// Checksums Length bytes of an open file starting at Offset with a CRC, whose
+// checksums of separate ranges of a file may be combined together later
+static std::optional<std::uint32_t> ChecksumFileCRC(
+	const FileReader& Reader, int FileHandle, std::uint64_t Offset,
+	std::uint64_t Length, CRC::Polynomial Poly)
+{
+	CRC::Hasher Hasher(Poly);
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+	// Holes in sparse files read back as zeros, whose checksum is found
+	// without reading any of them. File systems that do not track holes
+	// report the whole file as data.
+	const std::uint64_t EndOffset = Offset + Length;
+	for( std::uint64_t CurOffset = Offset; CurOffset < EndOffset; )
+	{
+		const off_t DataOffset = lseek(FileHandle, CurOffset, SEEK_DATA);
+
+		// ENXIO means that there is no more data past CurOffset
+		std::uint64_t DataBegin = CurOffset;
+		if( DataOffset >= 0 )
+		{
+			DataBegin = std::min<std::uint64_t>(DataOffset, EndOffset);
+		}
+		else if( errno == ENXIO )
+		{
+			DataBegin = EndOffset;
+		}
+
+		if( DataBegin > CurOffset )
+		{
+			Hasher = CRC::Hasher(
+				Poly, CRC::ChecksumZeros(
+						  DataBegin - CurOffset, Hasher.Finalize(), Poly));
+			CurOffset = DataBegin;
+			continue;
+		}
+
+		const off_t HoleOffset = lseek(FileHandle, CurOffset, SEEK_HOLE);
+
+		const std::uint64_t DataEnd
+			= HoleOffset > off_t(CurOffset)
+				? std::min<std::uint64_t>(HoleOffset, EndOffset)
+				: EndOffset;
+
+		if( !HashFileData(
+				Reader, FileHandle, CurOffset, DataEnd - CurOffset, Hasher) )
+		{
+			return std::nullopt;
+		}
+		CurOffset = DataEnd;
+	}
+#else
+	if( Length && !HashFileData(Reader, FileHandle, Offset, Length, Hasher) )
+	{
+		return std::nullopt;
+	}
+#endif
+
+	return Hasher.Finalize();
+}
+
+// Hashes the same data with each of several algorithms. Data is given to the
+// hashers a piece at a time, each small enough to still be in cache by the time
+// that the last of the hashers reads it, so that memory is only read once.
+class MultiHasher
+{
+public:
+	MultiHasher(
+		std::span<const HashAlgorithm> AlgorithmList, CRC::Polynomial Poly)
+		: Algorithms(AlgorithmList)
+	{
+		for( const HashAlgorithm CurAlgorithm : Algorithms )
+		{
+			switch( CurAlgorithm )
+			{
+			case HashAlgorithm::CRC:
+				Hashers.emplace_back(CRC::Hasher(Poly));
+				break;
+			case HashAlgorithm::XXH3:
+			case HashAlgorithm::XXH128:
+				Hashers.emplace_back(XXH::Hasher());
+				break;
+			case HashAlgorithm::SHA256:
+				Hashers.emplace_back(SHA::Hasher());
+				break;
+			case HashAlgorithm::MD5:
+				Hashers.emplace_back(MD5::Hasher());
+				break;
+			}
+		}
+	}
+
+	void Update(std::span<const std::byte> Data)
+	{
+		for( std::size_t Offset = 0; Offset < Data.size(); Offset += PieceSize )
+		{
+			const std::span<const std::byte> Piece = Data.subspan(
+				Offset, std::min(PieceSize, Data.size() - Offset));
+			for( auto& CurHasher : Hashers )
+			{
+				std::visit(
+					[Piece](auto& Hasher) { Hasher.Update(Piece); }, CurHasher);
+			}
+		}
+	}
+
+	DigestList Finalize() const
+	{
+		DigestList Checksums;
+		for( std::size_t i = 0; i < Algorithms.size(); ++i )
+		{
+			switch( Algorithms[i] )
+			{
+			case HashAlgorithm::CRC:
+				Checksums.push_back(
+					ToDigest(std::get<CRC::Hasher>(Hashers[i]).Finalize()));
+				break;
+			case HashAlgorithm::XXH3:
+				Checksums.push_back(
+					ToDigest(std::get<XXH::Hasher>(Hashers[i]).Finalize64()));
+				break;
+			case HashAlgorithm::XXH128:
+				Checksums.push_back(
+					ToDigest(std::get<XXH::Hasher>(Hashers[i]).Finalize128()));
+				break;
+			case HashAlgorithm::SHA256:
+				Checksums.push_back(
+					ToDigest(std::get<SHA::Hasher>(Hashers[i]).Finalize()));
+				break;
+			case HashAlgorithm::MD5:
+				Checksums.push_back(
+					ToDigest(std::get<MD5::Hasher>(Hashers[i]).Finalize()));
+				break;
+			}
+		}
+		return Checksums;
+	}
+
+private:
+	// Fits within the L2 cache of most processors
+	static constexpr std::size_t PieceSize = 256 * 1024;
+
+	using AnyHasher
+		= std::variant<CRC::Hasher, XXH::Hasher, SHA::Hasher, MD5::Hasher>;
+
+	std::span<const HashAlgorithm> Algorithms;
+	std::vector<AnyHasher>         Hashers;
+};
+
+static std::optional<DigestList> ChecksumFile(
+	const FileReader& Reader, const std::filesystem::path& Path,
+	std::uint64_t Offset, std::uint64_t Length,
+	std::span<const HashAlgorithm> Algorithms, CRC::Polynomial Poly)
+{
+	const int FileHandle = Reader.Open(Path);
+	if( FileHandle == -1 )
+	{
+		return std::nullopt;
+	}
+
+	struct stat FileStat = {};
+	if( fstat(FileHandle, &FileStat) != 0 )
+	{
+		close(FileHandle);
+		return std::nullopt;
+	}
+
+	std::optional<DigestList> Checksums;
+	if( !S_ISREG(FileStat.st_mode) )
+	{
+		MultiHasher Hasher(Algorithms, Poly);
+		if( HashFileStream(Reader, FileHandle, Hasher) )
+		{
+			Checksums = Hasher.Finalize();
+		}
+		close(FileHandle);
+		return Checksums;
+	}
+
+	// The file may have been truncated since it was queued, which would fault
+	// any mapped access past its new end
+	if( std::uint64_t(FileStat.st_size) < Offset + Length )
+	{
+		close(FileHandle);
+		return std::nullopt;
+	}
+
+	if( IsCRCOnly(Algorithms) )
+	{
+		if( const auto CRC32
+			= ChecksumFileCRC(Reader, FileHandle, Offset, Length, Poly) )
+		{
+			Checksums = DigestList{ToDigest(*CRC32)};
+		}
+	}
+	else
+	{
+		MultiHasher Hasher(Algorithms, Poly);
+		if( HashFileData(Reader, FileHandle, Offset, Length, Hasher) )
+		{
+			Checksums = Hasher.Finalize();
+		}
+	}
+
+	close(FileHandle);
+
+	return Checksums;
+}
+
+// A file to be hashed, along with the checksums of each of its ranges
+struct FileJob
 {
-	std::uint32_t     CRC32 = 0;
-	std::error_code   CurError;
-	const std::size_t FileSize = std::filesystem::file_size(Path, CurError);
+	std::filesystem::path Path;
+	// All of these are computed from the same read of the file
+	std::vector<HashAlgorithm> Algorithms;
+	std::uint64_t              Size = 0;
+	std::error_code            Error;
+	// The checksums of each range, one for each of the Algorithms
+	std::vector<std::optional<DigestList>> RangeChecksums;
+	std::atomic<std::size_t>               PendingRanges{0};
+};
+
+struct FileRange
+{
+	std::size_t   JobIndex;
+	std::size_t   RangeIndex;
+	std::uint64_t Offset;
+	std::uint64_t Length;
+};
+
+// Length of the single range of a stream, such as a pipe, which is read until
+// its end
+static constexpr std::uint64_t StreamLength
+	= std::numeric_limits<std::uint64_t>::max();
+
+// Splits each file into ranges of at most FileRangeSize bytes. Ranges are
+// queued in file-order so that idle workers help finish the files in progress.
+// Only CRC checksums can be combined, so files hashed with any other algorithm
+// are queued as a single range.
+static std::vector<FileRange> QueueFileRanges(std::span<FileJob> Jobs)
+{
+	std::vector<FileRange> Ranges;
+	for( std::size_t JobIndex = 0; JobIndex < Jobs.size(); ++JobIndex )
+	{
+		FileJob& CurJob = Jobs[JobIndex];
+
+		// Streams have no size to be split up by
+		const std::filesystem::file_status Status
+			= std::filesystem::status(CurJob.Path, CurJob.Error);
+		if( !CurJob.Error && std::filesystem::exists(Status)
+			&& !std::filesystem::is_regular_file(Status) )
+		{
+			CurJob.RangeChecksums.resize(1);
+			CurJob.PendingRanges.store(1, std::memory_order_relaxed);
+			Ranges.push_back(FileRange{JobIndex, 0, 0, StreamLength});
+			continue;
+		}
+
+		CurJob.Size = std::filesystem::file_size(CurJob.Path, CurJob.Error);
+		if( CurJob.Error )
+		{
+			// Still queue a single range, so that the error gets reported
+			CurJob.Size = 0;
+		}
+
+		const std::uint64_t RangeSize
+			= IsCRCOnly(CurJob.Algorithms)
+				? FileRangeSize
+				: std::max<std::uint64_t>(CurJob.Size, 1);
+
+		const std::size_t RangeCount = std::max<std::size_t>(
+			1, (CurJob.Size + RangeSize - 1) / RangeSize);
+
+		CurJob.RangeChecksums.resize(RangeCount);
+		CurJob.PendingRanges.store(RangeCount, std::memory_order_relaxed);
+
+		for( std::size_t i = 0; i < RangeCount; ++i )
+		{
+			const std::uint64_t Offset = i * RangeSize;
+			Ranges.push_back(FileRange{
+				JobIndex, i, Offset,
+				std::min(RangeSize, CurJob.Size - Offset)});
+		}
+	}
+	return Ranges;
+}
+
+// Files no larger than this are read whole and hashed in batches, rather than
+// being mapped one at a time
+static constexpr std::uint64_t SmallFileSize  = 64ull * 1024;
+static constexpr std::size_t   SmallFileBatch = 16;
+
+static bool IsSmallFile(const FileRange& Range)
+{
+	return Range.Offset == 0 && Range.Length <= SmallFileSize;
+}
+
+// Reads the first Size bytes of a file into Data, which direct reads may fill
+// past Size up to the end of the last block
+static bool ReadFile(
+	const FileReader& Reader, const std::filesystem::path& Path,
+	std::span<std::byte> Data, std::size_t Size)
+{
+	const int FileHandle = Reader.Open(Path);
+	if( FileHandle == -1 )
+	{
+		return false;
+	}
+
+	PageResidency Residency;
+	if( Reader.IsScrubbing() )
+	{
+		Residency = PageResidency(FileHandle, 0, Size);
+	}
+
+	const bool Result = ReadFully(FileHandle, Data, 0, Size);
+	Residency.Release(FileHandle, Size);
+	close(FileHandle);
+	return Result;
+}
+
+// Reads each of the small files of Ranges into its slot of FileData, and
+// returns which of them were read in whole. With io_uring, all of them are
+// read at once.
+static std::array<bool, SmallFileBatch> ReadSmallFiles(
+	const FileReader& Reader, std::span<FileJob> Jobs,
+	std::span<const FileRange>           Ranges,
+	std::span<const std::span<std::byte>> FileData)
+{
+	static_assert(SmallFileBatch <= RingQueueDepth);
+
+	std::array<bool, SmallFileBatch>          Loaded      = {};
+	std::array<int, SmallFileBatch>           FileHandles = {};
+	std::array<std::size_t, SmallFileBatch>   ReadSizes   = {};
+	std::array<PageResidency, SmallFileBatch> Residencies;
+
+	IOUring* const Ring = Reader.GetRing();
+
+	std::size_t InFlight = 0;
+	for( std::size_t i = 0; i < Ranges.size(); ++i )
+	{
+		const FileJob& CurJob = Jobs[Ranges[i].JobIndex];
+
+		FileHandles[i] = -1;
+		if( CurJob.Error )
+		{
+			continue;
+		}
+
+		if( !Ring )
+		{
+			Loaded[i]
+				= ReadFile(Reader, CurJob.Path, FileData[i], Ranges[i].Length);
+			continue;
+		}
+
+		FileHandles[i] = Reader.Open(CurJob.Path);
+		if( FileHandles[i] == -1 )
+		{
+			continue;
+		}
+
+		if( Ranges[i].Length == 0 )
+		{
+			Loaded[i] = true;
+			continue;
+		}
+		if( Reader.IsScrubbing() )
+		{
+			Residencies[i]
+				= PageResidency(FileHandles[i], 0, Ranges[i].Length);
+		}
+		// Read at once, should the ring have no room left
+		if( !Ring->QueueRead(FileHandles[i], FileData[i], 0, i) )
+		{
+			Loaded[i]
+				= ReadFully(FileHandles[i], FileData[i], 0, Ranges[i].Length);
+			continue;
+		}
+		++InFlight;
+	}
 
-	if( CurError )
+	while( InFlight )
 	{
-		return std::nullopt;
+		const std::optional<IOUring::Completion> CurCompletion
+			= Ring->WaitCompletion();
+		if( !CurCompletion.has_value() )
+		{
+			// The files may only be closed, and their data hashed, once
+			// nothing more is read into it
+			Ring->Drain();
+			break;
+		}
+		--InFlight;
+
+		const std::size_t Index = CurCompletion->UserData;
+		if( CurCompletion->Result <= 0 )
+		{
+			continue;
+		}
+
+		// Short reads are continued from wherever they left off
+		ReadSizes[Index] += CurCompletion->Result;
+		if( ReadSizes[Index] >= Ranges[Index].Length )
+		{
+			Loaded[Index] = true;
+			continue;
+		}
+		if( !Ring->QueueRead(
+				FileHandles[Index], FileData[Index].subspan(ReadSizes[Index]),
+				ReadSizes[Index], Index) )
+		{
+			Loaded[Index] = ReadFully(
+				FileHandles[Index], FileData[Index].subspan(ReadSizes[Index]),
+				ReadSizes[Index], Ranges[Index].Length - ReadSizes[Index]);
+			continue;
+		}
+		++InFlight;
 	}
 
-	const int FileHandle = open(Path.c_str(), O_RDONLY, 0);
-	if( FileHandle == -1 )
+	for( std::size_t i = 0; i < Ranges.size(); ++i )
 	{
-		return std::nullopt;
+		if( FileHandles[i] != -1 )
+		{
+			Residencies[i].Release(FileHandles[i], Ranges[i].Length);
+			close(FileHandles[i]);
+		}
 	}
 
-// Try to map the file, upon failure, use regular file-descriptor reads
-#if defined(__APPLE__)
-	void* FileMap
-		= mmap(nullptr, FileSize, PROT_READ, MAP_SHARED, FileHandle, 0);
-#else
-	void* FileMap = mmap(
-		nullptr, FileSize, PROT_READ, MAP_SHARED | MAP_POPULATE, FileHandle, 0);
-#endif
+	return Loaded;
+}
 
-	if( std::uintptr_t(FileMap) != -1ULL )
+// Small files of a single algorithm, read in and waiting to be hashed all at
+// once, with a checksum of type ChecksumT each
+template<typename ChecksumT>
+struct FileBatch
+{
+	std::array<std::span<const std::byte>, SmallFileBatch> Inputs;
+	std::array<ChecksumT, SmallFileBatch>                  Checksums;
+	std::array<FileJob*, SmallFileBatch>                   InputJobs;
+	std::array<std::size_t, SmallFileBatch>                DigestIndices;
+	std::size_t                                            InputCount = 0;
+
+	// DigestIndex is which of the checksums of the job this one is
+	void Add(
+		FileJob& Job, std::size_t DigestIndex, std::span<const std::byte> Data)
+	{
+		Inputs[InputCount]        = Data;
+		InputJobs[InputCount]     = &Job;
+		DigestIndices[InputCount] = DigestIndex;
+		++InputCount;
+	}
+
+	std::span<const std::span<const std::byte>> GetInputs() const
 	{
-		const auto FileData = std::span<const std::byte>(
-			reinterpret_cast<const std::byte*>(FileMap), FileSize);
+		return std::span(Inputs).first(InputCount);
+	}
 
-		madvise(FileMap, FileSize, MADV_SEQUENTIAL | MADV_WILLNEED);
+	// Hands each checksum, once computed, to the job of its file
+	void Finish()
+	{
+		for( std::size_t i = 0; i < InputCount; ++i )
+		{
+			InputJobs[i]->RangeChecksums[0].value()[DigestIndices[i]]
+				= ToDigest(Checksums[i]);
+		}
+	}
+};
 
-		CRC32 = CRC::Checksum(FileData);
+// Reads a batch of small files into Buffer and hashes all of them. CRC
+// checksums are all computed at once, interleaved with each other, as are
+// SHA-256 and MD5 hashes, in the lanes of vector registers.
+static void ChecksumSmallFiles(
+	const FileReader& Reader, std::span<FileJob> Jobs,
+	std::span<const FileRange> Ranges, CRC::Polynomial Poly,
+	std::vector<std::byte>& Buffer)
+{
+	// Each file is read into a slot of whole blocks, for direct reads
+	const std::size_t Alignment  = Reader.ReadAlignment();
+	std::uint64_t     BufferSize = 0;
+	for( const FileRange& CurRange : Ranges )
+	{
+		BufferSize += AlignUp(CurRange.Length, Alignment);
+	}
 
-		munmap((void*)FileMap, FileSize);
+	// Direct reads need aligned buffers, which the pool already has
+	static_assert(
+		SmallFileBatch * AlignUp(SmallFileSize, DirectAlignment)
+		<= BufferPoolSize);
+	std::span<std::byte> Slots;
+	if( Reader.IsDirect() )
+	{
+		Slots = Reader.GetBufferPool().first(BufferSize);
 	}
 	else
 	{
-		std::array<std::byte, 4096> Buffer;
+		Buffer.resize(BufferSize);
+		Slots = Buffer;
+	}
+
+	std::array<std::span<std::byte>, SmallFileBatch> FileSlots;
+	for( std::size_t i = 0; i < Ranges.size(); ++i )
+	{
+		FileSlots[i] = Slots.first(AlignUp(Ranges[i].Length, Alignment));
+		Slots        = Slots.subspan(FileSlots[i].size());
+	}
+
+	const std::array<bool, SmallFileBatch> Loaded = ReadSmallFiles(
+		Reader, Jobs, Ranges, std::span(FileSlots).first(Ranges.size()));
+
+	FileBatch<std::uint32_t>  CRCFiles;
+	FileBatch<SHA::Digest256> SHAFiles;
+	FileBatch<MD5::Digest128> MD5Files;
+
+	for( std::size_t j = 0; j < Ranges.size(); ++j )
+	{
+		const FileRange&           CurRange = Ranges[j];
+		FileJob&                   CurJob   = Jobs[CurRange.JobIndex];
+		const std::span<std::byte> FileData
+			= FileSlots[j].first(CurRange.Length);
+
+		if( !Loaded[j] )
+		{
+			continue;
+		}
 
-		ssize_t ReadCount = read(FileHandle, Buffer.data(), Buffer.size());
-		while( ReadCount > 0 )
+		DigestList& Checksums
+			= CurJob.RangeChecksums[0].emplace(CurJob.Algorithms.size());
+		for( std::size_t i = 0; i < CurJob.Algorithms.size(); ++i )
 		{
-			CRC32
-				= CRC::Checksum(std::span(Buffer).subspan(0, ReadCount), CRC32);
-			ReadCount = read(FileHandle, Buffer.data(), Buffer.size());
+			switch( CurJob.Algorithms[i] )
+			{
+			case HashAlgorithm::CRC:
+				CRCFiles.Add(CurJob, i, FileData);
+				break;
+			case HashAlgorithm::SHA256:
+				SHAFiles.Add(CurJob, i, FileData);
+				break;
+			case HashAlgorithm::MD5:
+				MD5Files.Add(CurJob, i, FileData);
+				break;
+			default:
+				Checksums[i] = HashData(FileData, CurJob.Algorithms[i], Poly);
+				break;
+			}
 		}
 	}
 
-	close(FileHandle);
+	CRC::Checksum(CRCFiles.GetInputs(), CRCFiles.Checksums, Poly);
+	CRCFiles.Finish();
+
+	SHA::Hash256(SHAFiles.GetInputs(), SHAFiles.Checksums);
+	SHAFiles.Finish();
+
+	MD5::Hash(MD5Files.GetInputs(), MD5Files.Checksums);
+	MD5Files.Finish();
+}
+
+// Hashes ranges from the queue until it is empty. Whichever worker finishes the
+// last range of a file merges the checksums of all of its ranges and passes the
+// result to FileDone.
+template<typename FileDoneT>
+static void HashFileRanges(
+	std::atomic<std::size_t>& RangeIndex, std::span<FileJob> Jobs,
+	std::span<const FileRange> Ranges, const Settings& CurSettings,
+	FileDoneT FileDone)
+{
+	const CRC::Polynomial Poly = CurSettings.Polynomial;
+
+	const FileReader Reader(
+		CurSettings.IO, CurSettings.Direct, CurSettings.Scrub);
+
+	std::vector<std::byte> SmallFileBuffer;
+
+	while( true )
+	{
+		// Claim a single range, or a run of consecutive small files
+		std::size_t BeginIndex = RangeIndex.load(std::memory_order_relaxed);
+		std::size_t EndIndex   = 0;
+		do
+		{
+			if( BeginIndex >= Ranges.size() )
+				return;
 
-	return CRC32;
+			EndIndex = BeginIndex + 1;
+			while( EndIndex < Ranges.size()
+				   && EndIndex - BeginIndex < SmallFileBatch
+				   && IsSmallFile(Ranges[BeginIndex])
+				   && IsSmallFile(Ranges[EndIndex]) )
+			{
+				++EndIndex;
+			}
+		} while( !RangeIndex.compare_exchange_weak(
+			BeginIndex, EndIndex, std::memory_order_relaxed) );
+
+		const std::span<const FileRange> CurRanges
+			= Ranges.subspan(BeginIndex, EndIndex - BeginIndex);
+
+		if( CurRanges.size() > 1 )
+		{
+			ChecksumSmallFiles(Reader, Jobs, CurRanges, Poly, SmallFileBuffer);
+		}
+		else if( FileJob& CurJob = Jobs[CurRanges[0].JobIndex]; !CurJob.Error )
+		{
+			CurJob.RangeChecksums[CurRanges[0].RangeIndex] = ChecksumFile(
+				Reader, CurJob.Path, CurRanges[0].Offset, CurRanges[0].Length,
+				CurJob.Algorithms, Poly);
+		}
+
+		for( const FileRange& CurRange : CurRanges )
+		{
+			FileJob& CurJob = Jobs[CurRange.JobIndex];
+
+			if( CurJob.PendingRanges.fetch_sub(1, std::memory_order_acq_rel)
+				!= 1 )
+			{
+				continue;
+			}
+
+			// Only lone CRC checksums are ever split into more than one range
+			std::optional<DigestList> Checksums = CurJob.RangeChecksums[0];
+			for( std::size_t i = 1;
+				 Checksums.has_value() && i < CurJob.RangeChecksums.size();
+				 ++i )
+			{
+				if( !CurJob.RangeChecksums[i].has_value() )
+				{
+					Checksums = std::nullopt;
+					break;
+				}
+				const std::uint64_t Offset = i * FileRangeSize;
+
+				Checksums->front() = ToDigest(CRC::Combine(
+					DigestCRC32(Checksums->front()),
+					DigestCRC32(CurJob.RangeChecksums[i]->front()),
+					std::min(FileRangeSize, CurJob.Size - Offset), Poly));
+			}
+
+			FileDone(CurJob, Checksums);
+		}
+	}
 }
 
 struct CheckEntry
 {
 	std::filesystem::path FilePath;
-	std::uint32_t         Checksum;
+	HashAlgorithm         Algorithm;
+	Digest                Checksum;
+	// Which of the checksums of the job of the file this entry is checked with
+	std::size_t DigestIndex = 0;
 };
 
+// JobEntries holds the indices of the entries of Checkqueue that are checked
+// against each job
 static void CheckerThread(
 	std::atomic<std::size_t>& Passed, std::atomic<std::size_t>& QueueLock,
-	std::span<const CheckEntry> Checkqueue, std::size_t WorkerIndex)
+	std::span<const CheckEntry>               Checkqueue,
+	std::span<const std::vector<std::size_t>> JobEntries,
+	std::span<FileJob> Jobs, std::span<const FileRange> Ranges,
+	const Settings& CurSettings, std::size_t WorkerIndex)
 {
 #ifdef _POSIX_VERSION
 	char ThreadName[16] = {0};
@@ -97,36 +1723,264 @@ static void CheckerThread(
 #endif
 #endif
 
-	while( true )
+	HashFileRanges(
+		QueueLock, Jobs, Ranges, CurSettings,
+		[&](const FileJob& CurJob, const std::optional<DigestList>& Checksums) {
+			for( const std::size_t EntryIndex :
+				 JobEntries[&CurJob - Jobs.data()] )
+			{
+				const CheckEntry& CurEntry = Checkqueue[EntryIndex];
+				const std::string Expected
+					= FormatDigest(CurEntry.Checksum, CurEntry.Algorithm);
+
+				if( Checksums.has_value() )
+				{
+					const Digest& CurSum = (*Checksums)[CurEntry.DigestIndex];
+					const bool    Valid  = CurEntry.Checksum == CurSum;
+					std::printf(
+						"\e[36m%s\t\e[33m%s\e[37m...%s%s\t%s\e[0m\n",
+						CurEntry.FilePath.c_str(), Expected.c_str(),
+						Valid ? "\e[32m" : "\e[31m",
+						FormatDigest(CurSum, CurEntry.Algorithm).c_str(),
+						Valid ? "\e[32mOK" : "\e[31mFAIL");
+
+					Passed.fetch_add(Valid, std::memory_order_relaxed);
+				}
+				else
+				{
+					std::printf(
+						"\e[36m%s\t\e[33m%s\t\t\e[31mError opening "
+						"file\n",
+						CurEntry.FilePath.c_str(), Expected.c_str());
+				}
+			}
+		});
+}
+
+struct ChecksumLine
+{
+	std::string   PathString;
+	HashAlgorithm Algorithm;
+	Digest        Checksum;
+};
+
+// Escapes a file name the way sha256sum does, so that it fits on one line
+static std::string EscapePath(std::string_view PathString)
+{
+	std::string Result;
+	for( const char CurChar : PathString )
 	{
-		const std::size_t EntryIndex
-			= QueueLock.fetch_add(1, std::memory_order_relaxed);
-		if( EntryIndex >= Checkqueue.size() )
-			return;
-		const CheckEntry& CurEntry = Checkqueue[EntryIndex];
+		switch( CurChar )
+		{
+		case '\\':
+			Result += "\\\\";
+			break;
+		case '\n':
+			Result += "\\n";
+			break;
+		case '\r':
+			Result += "\\r";
+			break;
+		default:
+			Result.push_back(CurChar);
+			break;
+		}
+	}
+	return Result;
+}
+
+// Undoes the escaping of sha256sum, which writes file names with backslashes
+// or line breaks in them as "\\", "\n", and "\r"
+static std::string UnescapePath(std::string_view PathString)
+{
+	std::string Result;
+	for( std::size_t i = 0; i < PathString.size(); ++i )
+	{
+		if( PathString[i] != '\\' || i + 1 == PathString.size() )
+		{
+			Result.push_back(PathString[i]);
+			continue;
+		}
+
+		switch( PathString[++i] )
+		{
+		case 'n':
+			Result.push_back('\n');
+			break;
+		case 'r':
+			Result.push_back('\r');
+			break;
+		default:
+			Result.push_back(PathString[i]);
+			break;
+		}
+	}
+	return Result;
+}
+
+// Parses any of:
+//  An SFV line of the form "<path> <crc32>"
+//  A tagged line of the form "<algorithm> (<path>) = <digest>", as written by
+//  xxhsum --tag, sha256sum --tag, and md5sum --tag
+//  A line of the form "<digest>  <path>", as written by sha256sum and md5sum,
+//  where the second space is a '*' for files hashed in binary mode
+static std::optional<ChecksumLine> ParseChecksumLine(std::string_view Line)
+{
+	// Lines of file names that had to be escaped begin with a backslash, but
+	// only in the formats of sha256sum and md5sum. SFV lines are never escaped,
+	// so their file names may begin with a backslash of their own.
+	const bool             Escaped     = Line.starts_with('\\');
+	const std::string_view HashingLine = Escaped ? Line.substr(1) : Line;
 
-		const std::optional<std::uint32_t> CurSum
-			= ChecksumFile(CurEntry.FilePath);
+	// Told apart by the length of the digest
+	for( const HashAlgorithm CurAlgorithm :
+		 {HashAlgorithm::SHA256, HashAlgorithm::MD5} )
+	{
+		const std::size_t HexSize = DigestSize(CurAlgorithm) * 2;
+		if( HashingLine.size() <= HexSize + 2 || HashingLine[HexSize] != ' '
+			|| (HashingLine[HexSize + 1] != ' '
+				&& HashingLine[HexSize + 1] != '*') )
+		{
+			continue;
+		}
 
-		if( CurSum.has_value() )
+		const std::optional<Digest> Checksum
+			= ParseDigest(HashingLine.substr(0, HexSize), CurAlgorithm);
+		if( Checksum.has_value() )
 		{
-			const bool Valid = CurEntry.Checksum == CurSum;
-			std::printf(
-				"\e[36m%s\t\e[33m%08X\e[37m...%s%08X\t%s\e[0m\n",
-				CurEntry.FilePath.c_str(), CurEntry.Checksum,
-				Valid ? "\e[32m" : "\e[31m", CurSum.value(),
-				Valid ? "\e[32mOK" : "\e[31mFAIL");
+			const std::string_view PathString = HashingLine.substr(HexSize + 2);
+			return ChecksumLine{
+				Escaped ? UnescapePath(PathString) : std::string(PathString),
+				CurAlgorithm, Checksum.value()};
+		}
+	}
 
-			Passed.fetch_add(Valid, std::memory_order_relaxed);
+	for( const HashAlgorithm CurAlgorithm :
+		 {HashAlgorithm::XXH3, HashAlgorithm::XXH128, HashAlgorithm::SHA256,
+		  HashAlgorithm::MD5} )
+	{
+		const std::string_view Tag = AlgorithmTag(CurAlgorithm);
+		if( !HashingLine.starts_with(Tag)
+			|| !HashingLine.substr(Tag.size()).starts_with(" (") )
+		{
+			continue;
 		}
-		else
+		const std::size_t BreakPos = HashingLine.rfind(") = ");
+		if( BreakPos == std::string_view::npos || BreakPos < Tag.size() + 2 )
+		{
+			return std::nullopt;
+		}
+		const std::optional<Digest> Checksum
+			= ParseDigest(HashingLine.substr(BreakPos + 4), CurAlgorithm);
+		if( !Checksum.has_value() )
+		{
+			return std::nullopt;
+		}
+		const std::string_view PathString
+			= HashingLine.substr(Tag.size() + 2, BreakPos - (Tag.size() + 2));
+		return ChecksumLine{
+			Escaped ? UnescapePath(PathString) : std::string(PathString),
+			CurAlgorithm, Checksum.value()};
+	}
+
+	const std::size_t      BreakPos    = Line.find_last_of(' ');
+	const std::string_view CheckString = Line.substr(BreakPos + 1);
+	std::uint32_t          CheckValue  = ~0u;
+	const std::from_chars_result ParseResult = std::from_chars<std::uint32_t>(
+		CheckString.begin(), CheckString.end(), CheckValue, 16);
+	if( ParseResult.ec != std::errc() )
+	{
+		return std::nullopt;
+	}
+	return ChecksumLine{
+		std::string(Line.substr(0, BreakPos)), HashAlgorithm::CRC,
+		ToDigest(CheckValue)};
+}
+
+// Where the CRC kernel profile of this machine is cached, or an empty path if
+// there is nowhere to cache it
+static std::filesystem::path CRCProfilePath()
+{
+	std::filesystem::path CachePath;
+	if( const char* CacheHome = std::getenv("XDG_CACHE_HOME");
+		CacheHome && *CacheHome )
+	{
+		CachePath = CacheHome;
+	}
+	else if( const char* Home = std::getenv("HOME"); Home && *Home )
+	{
+		CachePath = std::filesystem::path(Home) / ".cache";
+	}
+	else
+	{
+		return {};
+	}
+	return CachePath / "qCheck" / "crc32.profile";
+}
+
+void LoadCRCProfile(const Settings& CurSettings)
+{
+	const std::filesystem::path ProfilePath = CRCProfilePath();
+
+	if( !CurSettings.Calibrate )
+	{
+		// Only CRC checksums have kernels to choose between, though checksum
+		// files to be verified may hold CRC checksums of their own
+		if( !CurSettings.Check
+			&& std::find(
+				   CurSettings.Algorithms.begin(), CurSettings.Algorithms.end(),
+				   HashAlgorithm::CRC)
+				   == CurSettings.Algorithms.end() )
+		{
+			return;
+		}
+
+		// Without a profile of this machine, the built-in kernels are used
+		if( ProfilePath.empty() )
+		{
+			return;
+		}
+		std::ifstream ProfileFile(ProfilePath);
+		if( !ProfileFile )
 		{
-			std::printf(
-				"\e[36m%s\t\e[33m%08X\t\t\e[31mError opening "
-				"file\n",
-				CurEntry.FilePath.c_str(), CurEntry.Checksum);
+			return;
 		}
+		const std::string Profile(
+			(std::istreambuf_iterator<char>(ProfileFile)),
+			std::istreambuf_iterator<char>());
+		CRC::LoadProfile(Profile);
+		return;
+	}
+
+	const std::string Profile = CRC::Calibrate();
+	if( ProfilePath.empty() )
+	{
+		std::fprintf(
+			stderr, "Nowhere to write CRC profile, neither $XDG_CACHE_HOME "
+					"nor $HOME is set\n");
+		return;
+	}
+
+	// Written to a file of its own and then renamed into place, so that other
+	// runs only ever find all of one profile or another
+	std::filesystem::path TempPath = ProfilePath;
+	TempPath += '.' + std::to_string(getpid());
+
+	std::error_code CurError;
+	std::filesystem::create_directories(ProfilePath.parent_path(), CurError);
+	std::ofstream ProfileFile(TempPath, std::ios::trunc);
+	ProfileFile << Profile;
+	ProfileFile.close();
+	if( !ProfileFile
+		|| std::rename(TempPath.c_str(), ProfilePath.c_str()) != 0 )
+	{
+		std::filesystem::remove(TempPath, CurError);
+		std::fprintf(
+			stderr, "Failed to write CRC profile \"%s\"\n",
+			ProfilePath.c_str());
+		return;
 	}
+	std::fprintf(stderr, "Wrote CRC profile \"%s\"\n", ProfilePath.c_str());
 }
 
 int CheckSFV(const Settings& CurSettings)
@@ -152,16 +2006,9 @@ int CheckSFV(const Settings& CurSettings)
 		{
 			if( CurLine[0] == ';' )
 				continue;
-			const std::size_t      BreakPos = CurLine.find_last_of(' ');
-			const std::string_view PathString
-				= std::string_view(CurLine).substr(0, BreakPos);
-			const std::string_view CheckString
-				= std::string_view(CurLine).substr(BreakPos + 1);
-			std::uint32_t                CheckValue = ~0u;
-			const std::from_chars_result ParseResult
-				= std::from_chars<std::uint32_t>(
-					CheckString.begin(), CheckString.end(), CheckValue, 16);
-			if( ParseResult.ec != std::errc() )
+			const std::optional<ChecksumLine> CurEntry
+				= ParseChecksumLine(CurLine);
+			if( !CurEntry.has_value() )
 			{
 				// Error parsing checksum value
 				continue;
@@ -176,10 +2023,49 @@ int CheckSFV(const Settings& CurSettings)
 			{
 				FilePath = ".";
 			}
-			FilePath /= PathString;
-			Checkqueue.push_back(CheckEntry{FilePath, CheckValue});
+			FilePath /= CurEntry->PathString;
+			Checkqueue.push_back(CheckEntry{
+				FilePath, CurEntry->Algorithm, CurEntry->Checksum});
+		}
+	}
+
+	// All entries of the same file, such as the lines of each algorithm of a
+	// combined manifest, are checked from a single read of it
+	std::unordered_map<std::string, std::size_t> JobIndices;
+	std::vector<std::vector<std::size_t>>        JobEntries;
+	for( std::size_t i = 0; i < Checkqueue.size(); ++i )
+	{
+		const auto [JobIndex, Inserted] = JobIndices.try_emplace(
+			Checkqueue[i].FilePath.native(), JobEntries.size());
+		if( Inserted )
+		{
+			JobEntries.emplace_back();
+		}
+		JobEntries[JobIndex->second].push_back(i);
+	}
+
+	std::vector<FileJob> Jobs(JobEntries.size());
+	for( std::size_t i = 0; i < Jobs.size(); ++i )
+	{
+		FileJob& CurJob = Jobs[i];
+		CurJob.Path     = Checkqueue[JobEntries[i][0]].FilePath;
+
+		// Entries of the same algorithm share the one checksum
+		for( const std::size_t EntryIndex : JobEntries[i] )
+		{
+			CheckEntry& CurEntry = Checkqueue[EntryIndex];
+
+			const auto Found = std::find(
+				CurJob.Algorithms.begin(), CurJob.Algorithms.end(),
+				CurEntry.Algorithm);
+			CurEntry.DigestIndex = Found - CurJob.Algorithms.begin();
+			if( Found == CurJob.Algorithms.end() )
+			{
+				CurJob.Algorithms.push_back(CurEntry.Algorithm);
+			}
 		}
 	}
+	const std::vector<FileRange> Ranges = QueueFileRanges(Jobs);
 
 	std::vector<std::thread> Workers;
 	std::atomic<std::size_t> Passed{0};
@@ -188,7 +2074,8 @@ int CheckSFV(const Settings& CurSettings)
 	{
 		Workers.push_back(std::thread(
 			CheckerThread, std::ref(Passed), std::ref(QueueLock),
-			std::span(Checkqueue), i));
+			std::span(Checkqueue), std::span(JobEntries), std::span(Jobs),
+			std::span(Ranges), std::cref(CurSettings), i));
 	}
 
 	for( std::thread& Worker : Workers )
@@ -199,9 +2086,67 @@ int CheckSFV(const Settings& CurSettings)
 	return Checkqueue.size() == Passed.load() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+// Writes the line of a file to the manifest of one algorithm. Output to a
+// terminal is colored instead, and names the algorithm when Labeled.
+static void WriteChecksumLine(
+	std::FILE* Output, const std::filesystem::path& Path,
+	HashAlgorithm Algorithm, const Digest& Checksum, bool Labeled)
+{
+	const std::string DigestString = FormatDigest(Checksum, Algorithm);
+	if( isatty(fileno(Output)) )
+	{
+		std::fprintf(
+			Output, "\e[36m%s\t%s%s\e[33m%s\e[0m\n", Path.filename().c_str(),
+			Labeled ? AlgorithmTag(Algorithm) : "", Labeled ? "\t" : "",
+			DigestString.c_str());
+	}
+	else if( Algorithm == HashAlgorithm::CRC )
+	{
+		std::fprintf(
+			Output, "%s %s\n", Path.filename().c_str(), DigestString.c_str());
+	}
+	else
+	{
+		// File names are escaped the same way as sha256sum does, with the
+		// line marked by a leading backslash
+		const std::string FileName = Path.filename().string();
+		const std::string Escaped  = EscapePath(FileName);
+		const char*       Marker   = Escaped != FileName ? "\\" : "";
+
+		if( Algorithm == HashAlgorithm::SHA256
+			|| Algorithm == HashAlgorithm::MD5 )
+		{
+			std::fprintf(
+				Output, "%s%s  %s\n", Marker, DigestString.c_str(),
+				Escaped.c_str());
+		}
+		else
+		{
+			std::fprintf(
+				Output, "%s%s (%s) = %s\n", Marker, AlgorithmTag(Algorithm),
+				Escaped.c_str(), DigestString.c_str());
+		}
+	}
+}
+
+static void WriteErrorLine(std::FILE* Output, const std::filesystem::path& Path)
+{
+	if( isatty(fileno(Output)) )
+	{
+		std::fprintf(
+			Output, "\e[36m%s\t\e[31mERROR\e[0m\n", Path.filename().c_str());
+	}
+	else
+	{
+		std::fprintf(Output, "%s ERROR\n", Path.filename().c_str());
+	}
+}
+
+// Outputs holds the manifest to write the checksums of each algorithm to
 static void GenCheckThread(
-	std::atomic<std::size_t>&              FileIndex,
-	std::span<const std::filesystem::path> FileList, std::size_t WorkerIndex)
+	std::atomic<std::size_t>& FileIndex, std::span<FileJob> Jobs,
+	std::span<const FileRange> Ranges, std::span<std::FILE* const> Outputs,
+	const Settings& CurSettings, std::size_t WorkerIndex)
 {
 
 #ifdef _POSIX_VERSION
@@ -215,59 +2160,52 @@ static void GenCheckThread(
 #endif
 #endif
 
-	while( true )
-	{
-		const std::size_t EntryIndex = FileIndex.fetch_add(1);
-		if( EntryIndex >= FileList.size() )
-			return;
-		const std::filesystem::path&       CurPath = FileList[EntryIndex];
-		const std::optional<std::uint32_t> CRC32   = ChecksumFile(CurPath);
-		// If writing to a terminal, put some pretty colored output
-		if( CRC32.has_value() )
-		{
-			if( isatty(fileno(stdout)) )
-			{
-				std::fprintf(
-					stdout, "\e[36m%s\t\e[33m%08X\e[0m\n",
-					CurPath.filename().c_str(), CRC32.value());
-			}
-			else
-			{
-				std::fprintf(
-					stdout, "%s %08X\n", CurPath.filename().c_str(),
-					CRC32.value());
-			}
-		}
-		else
-		{
-			if( isatty(fileno(stdout)) )
-			{
-				std::fprintf(
-					stdout, "\e[36m%s\t\e[31mERROR\e[0m\n",
-					CurPath.filename().c_str());
-			}
-			else
+	HashFileRanges(
+		FileIndex, Jobs, Ranges, CurSettings,
+		[Outputs](
+			const FileJob& CurJob, const std::optional<DigestList>& Checksums) {
+			for( std::size_t i = 0; i < Outputs.size(); ++i )
 			{
-				std::fprintf(stdout, "%s ERROR\n", CurPath.filename().c_str());
+				// Algorithms that share a manifest are labeled apart, and
+				// errors are only reported once to each manifest
+				const auto Begin = Outputs.begin();
+				const bool Shared
+					= std::count(Begin, Outputs.end(), Outputs[i]) > 1;
+				const bool Reported
+					= std::find(Begin, Begin + i, Outputs[i]) != Begin + i;
+
+				if( Checksums.has_value() )
+				{
+					WriteChecksumLine(
+						Outputs[i], CurJob.Path, CurJob.Algorithms[i],
+						(*Checksums)[i], Shared);
+				}
+				else if( !Reported )
+				{
+					WriteErrorLine(Outputs[i], CurJob.Path);
+				}
 			}
-		}
-	}
+		});
 }
 
-int GenerateSFV(const Settings& CurSettings)
+// SFV Header
+// https://en.wikipedia.org/wiki/Simple_file_verification
+static void WriteSFVHeader(std::FILE* Output, const Settings& CurSettings)
 {
-	// SFV Header
-	// https://en.wikipedia.org/wiki/Simple_file_verification
-
-	// Parse file list
 	std::fprintf(
-		stdout,
+		Output,
 		"; Generated with qCheck by Wunkolo [ Build: " __TIMESTAMP__ " ]\n");
 
 	for( const auto& CurPath : CurSettings.InputFiles )
 	{
-		std::error_code   CurError;
-		const std::size_t FileSize = std::filesystem::file_size(CurPath);
+		// Streams, such as pipes, have no size to list
+		std::error_code CurError;
+		std::uintmax_t  FileSize
+			= std::filesystem::file_size(CurPath, CurError);
+		if( CurError )
+		{
+			FileSize = 0;
+		}
 
 		char        TimeString[64] = {0};
 		struct stat FileStat       = {};
@@ -280,9 +2218,57 @@ int GenerateSFV(const Settings& CurSettings)
 				std::localtime(&FileTime));
 		}
 		std::fprintf(
-			stdout, "; %.64s %zu %s\n", TimeString, FileSize,
+			Output, "; %.64s %ju %s\n", TimeString, FileSize,
 			CurPath.filename().c_str());
 	}
+}
+
+int GenerateSFV(const Settings& CurSettings)
+{
+	const std::span<const HashAlgorithm> Algorithms = CurSettings.Algorithms;
+
+	// Every manifest goes to stdout, unless each has a file of its own
+	std::vector<std::FILE*> Outputs(Algorithms.size(), stdout);
+	if( !CurSettings.OutputPrefix.empty() )
+	{
+		for( std::size_t i = 0; i < Algorithms.size(); ++i )
+		{
+			std::filesystem::path OutputPath = CurSettings.OutputPrefix;
+			OutputPath += '.';
+			OutputPath += AlgorithmExtension(Algorithms[i]);
+
+			Outputs[i] = std::fopen(OutputPath.c_str(), "w");
+			if( !Outputs[i] )
+			{
+				std::fprintf(
+					stderr, "Failed to open \"%s\" for writing\n",
+					OutputPath.c_str());
+				for( std::size_t j = 0; j < i; ++j )
+				{
+					std::fclose(Outputs[j]);
+				}
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	// Tagged checksum lines have no comment syntax, so only SFV files get a
+	// header
+	for( std::size_t i = 0; i < Algorithms.size(); ++i )
+	{
+		if( Algorithms[i] == HashAlgorithm::CRC )
+		{
+			WriteSFVHeader(Outputs[i], CurSettings);
+		}
+	}
+
+	std::vector<FileJob> Jobs(CurSettings.InputFiles.size());
+	for( std::size_t i = 0; i < CurSettings.InputFiles.size(); ++i )
+	{
+		Jobs[i].Path       = CurSettings.InputFiles[i];
+		Jobs[i].Algorithms = CurSettings.Algorithms;
+	}
+	const std::vector<FileRange> Ranges = QueueFileRanges(Jobs);
 
 	std::atomic<std::size_t> FileIndex(0);
 	std::vector<std::thread> Workers;
@@ -290,7 +2276,8 @@ int GenerateSFV(const Settings& CurSettings)
 	for( std::size_t i = 0; i < CurSettings.Threads; ++i )
 	{
 		Workers.push_back(std::thread(
-			&GenCheckThread, std::ref(FileIndex), CurSettings.InputFiles, i));
+			&GenCheckThread, std::ref(FileIndex), std::span(Jobs),
+			std::span(Ranges), std::span(Outputs), std::cref(CurSettings), i));
 	}
 
 	for( std::thread& Worker : Workers )
@@ -298,5 +2285,13 @@ int GenerateSFV(const Settings& CurSettings)
 		Worker.join();
 	}
 
-	return EXIT_SUCCESS;
-}
\ No newline at end of file
+	int Result = EXIT_SUCCESS;
+	for( std::FILE* CurOutput : Outputs )
+	{
+		if( CurOutput != stdout && std::fclose(CurOutput) != 0 )
+		{
+			Result = EXIT_FAILURE;
+		}
+	}
+	return Result;
+}
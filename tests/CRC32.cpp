@@ -3,7 +3,9 @@
 #include <array>
 #include <random>
 #include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -205,6 +207,409 @@ TEST_CASE("mt19937_32x1024x2 Combine", "[CRC32]")
 	const std::uint32_t ChecksumABCombine
 		= CRC::Checksum(std::as_bytes(std::span{DataB}), ChecksumA);
 	REQUIRE(ChecksumABCombine == 0x2E0FE81B);
+
+	const std::uint32_t ChecksumABMerge
+		= CRC::Combine(ChecksumA, ChecksumB, sizeof(DataB));
+	REQUIRE(ChecksumABMerge == 0x2E0FE81B);
+}
+
+TEST_CASE("mt19937_32x997 (byte) Combine", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		const std::uint32_t Checksum = CRC::Checksum(Bytes, 0, CurPoly);
+		for( const std::size_t Split : {0, 1, 15, 64, 500, 996, 997} )
+		{
+			const std::uint32_t ChecksumA
+				= CRC::Checksum(Bytes.first(Split), 0, CurPoly);
+			const std::uint32_t ChecksumB
+				= CRC::Checksum(Bytes.subspan(Split), 0, CurPoly);
+			REQUIRE(
+				CRC::Combine(
+					ChecksumA, ChecksumB, Bytes.size() - Split, CurPoly)
+				== Checksum);
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x997 (byte) Short and unaligned", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data}).subspan(1);
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		// Every length should agree with a byte-at-a-time checksum
+		std::uint32_t Checksum = 0;
+		for( std::size_t Length = 0; Length < 160; ++Length )
+		{
+			REQUIRE(
+				CRC::Checksum(Bytes.first(Length), 0, CurPoly) == Checksum);
+			Checksum
+				= CRC::Checksum(Bytes.subspan(Length, 1), Checksum, CurPoly);
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x997 (byte) Batch", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	// Inputs of varying lengths and alignments, more than fit in a single batch
+	std::vector<std::span<const std::byte>> Inputs;
+	for( const std::size_t Length :
+		 {0, 1, 3, 4, 15, 16, 17, 33, 64, 100, 127, 128, 129, 200, 500, 997} )
+	{
+		Inputs.push_back(Bytes.first(Length));
+		Inputs.push_back(Bytes.last(Length / 2));
+	}
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		std::vector<std::uint32_t> Checksums(Inputs.size());
+		CRC::Checksum(Inputs, Checksums, CurPoly);
+
+		for( std::size_t i = 0; i < Inputs.size(); ++i )
+		{
+			REQUIRE(Checksums[i] == CRC::Checksum(Inputs[i], 0, CurPoly));
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x997 (byte) Static polynomial", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const std::size_t Length : {0, 1, 5, 16, 63, 64, 200, 997} )
+	{
+		const auto Input = Bytes.first(Length);
+
+		REQUIRE(
+			CRC::Checksum<CRC::Polynomial::CRC32>(Input, 0x12345678)
+			== CRC::Checksum(Input, 0x12345678, CRC::Polynomial::CRC32));
+		REQUIRE(
+			CRC::Checksum<CRC::Polynomial::CRC32C>(Input, 0x12345678)
+			== CRC::Checksum(Input, 0x12345678, CRC::Polynomial::CRC32C));
+		REQUIRE(
+			CRC::Checksum<CRC::Polynomial::CRC32K>(Input, 0x12345678)
+			== CRC::Checksum(Input, 0x12345678, CRC::Polynomial::CRC32K));
+		REQUIRE(
+			CRC::Checksum<CRC::Polynomial::CRC32K2>(Input, 0x12345678)
+			== CRC::Checksum(Input, 0x12345678, CRC::Polynomial::CRC32K2));
+		REQUIRE(
+			CRC::Checksum<CRC::Polynomial::CRC32Q>(Input, 0x12345678)
+			== CRC::Checksum(Input, 0x12345678, CRC::Polynomial::CRC32Q));
+	}
+}
+
+TEST_CASE("mt19937_32x997 (byte) Segments", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	// Segments of uneven sizes, including empty ones, that cover all of Data
+	std::vector<std::span<const std::byte>> Segments;
+	for( std::size_t Offset = 0, Length = 0; Offset < Bytes.size();
+		 Offset += Length, Length = (Length * 7 + 3) % 150 )
+	{
+		Segments.push_back(
+			Bytes.subspan(Offset, std::min(Length, Bytes.size() - Offset)));
+	}
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		REQUIRE(
+			CRC::ChecksumSegments(Segments, 0x12345678, CurPoly)
+			== CRC::Checksum(Bytes, 0x12345678, CurPoly));
+	}
+}
+
+TEST_CASE("Zeros", "[CRC32]")
+{
+	const std::vector<std::byte> Zeros(5000);
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		for( const std::size_t Length : {0, 1, 3, 64, 1000, 4096, 5000} )
+		{
+			REQUIRE(
+				CRC::ChecksumZeros(Length, 0x12345678, CurPoly)
+				== CRC::Checksum(
+					std::span(Zeros).first(Length), 0x12345678, CurPoly));
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x997 (byte) Hasher", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const CRC::Polynomial CurPoly :
+		 {CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		  CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		  CRC::Polynomial::CRC32Q} )
+	{
+		// Chunk sizes that leave partial blocks behind between updates
+		for( const std::size_t ChunkSize : {1, 7, 16, 63, 64, 100, 333, 997} )
+		{
+			CRC::Hasher Hasher(CurPoly, 0x12345678);
+			REQUIRE(Hasher.Finalize() == 0x12345678);
+
+			for( std::size_t i = 0; i < Bytes.size(); i += ChunkSize )
+			{
+				Hasher.Update(Bytes.subspan(
+					i, std::min(ChunkSize, Bytes.size() - i)));
+			}
+
+			REQUIRE(
+				Hasher.Finalize()
+				== CRC::Checksum(Bytes, 0x12345678, CurPoly));
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x4096 (byte) Calibrate", "[CRC32]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::vector<std::uint8_t> Data(4096 * 4);
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	constexpr CRC::Polynomial Polynomials[] = {
+		CRC::Polynomial::CRC32, CRC::Polynomial::CRC32C,
+		CRC::Polynomial::CRC32K, CRC::Polynomial::CRC32K2,
+		CRC::Polynomial::CRC32Q};
+
+	// Lengths within each size class, from a misaligned start
+	std::vector<std::span<const std::byte>> Inputs;
+	for( std::size_t Length = 0; Length < Bytes.size() - 3;
+		 Length = Length * 3 + 1 )
+	{
+		Inputs.push_back(Bytes.subspan(3, Length));
+	}
+
+	std::vector<std::uint32_t> Expected;
+	for( const CRC::Polynomial CurPoly : Polynomials )
+	{
+		for( const auto& CurInput : Inputs )
+		{
+			Expected.push_back(CRC::Checksum(CurInput, 0x12345678, CurPoly));
+		}
+	}
+
+	// Whichever kernels are chosen, the checksums must not change
+	const auto CheckAll = [&]() {
+		std::size_t i = 0;
+		for( const CRC::Polynomial CurPoly : Polynomials )
+		{
+			for( const auto& CurInput : Inputs )
+			{
+				REQUIRE(
+					CRC::Checksum(CurInput, 0x12345678, CurPoly)
+					== Expected[i]);
+
+				// Hashers fold with the kernel chosen for the largest inputs
+				CRC::Hasher CurHasher(CurPoly, 0x12345678);
+				CurHasher.Update(CurInput.first(CurInput.size() / 3));
+				CurHasher.Update(CurInput.subspan(CurInput.size() / 3));
+				REQUIRE(CurHasher.Finalize() == Expected[i++]);
+			}
+		}
+	};
+
+	const std::string Profile = CRC::Calibrate();
+	CheckAll();
+
+	REQUIRE(CRC::LoadProfile(Profile));
+	CheckAll();
+
+	// Every size class using the kernel that was chosen for the smallest one
+	const std::size_t NameStart = Profile.find("\ncrc32 ") + 7;
+	const std::string Kernel
+		= Profile.substr(NameStart, Profile.find(' ', NameStart) - NameStart);
+	const std::string Header       = Profile.substr(0, Profile.find('\n') + 1);
+	std::string       SmallProfile = Header;
+	for( const std::string_view CurName :
+		 {"crc32", "crc32c", "crc32k", "crc32k2", "crc32q"} )
+	{
+		SmallProfile += CurName;
+		for( std::size_t i = 0; i < 8; ++i )
+		{
+			SmallProfile += ' ';
+			SmallProfile += Kernel;
+		}
+		SmallProfile += '\n';
+	}
+	REQUIRE(CRC::LoadProfile(SmallProfile));
+	CheckAll();
+
+	REQUIRE_FALSE(CRC::LoadProfile(""));
+	REQUIRE_FALSE(CRC::LoadProfile("garbage"));
+	REQUIRE_FALSE(CRC::LoadProfile(Profile.substr(Profile.find('\n') + 1)));
+	REQUIRE_FALSE(CRC::LoadProfile(
+		Header + "crc32 NoSuchKernel NoSuchKernel NoSuchKernel NoSuchKernel "
+				 "NoSuchKernel NoSuchKernel NoSuchKernel NoSuchKernel\n"));
+	// Measured upon some other processor
+	REQUIRE_FALSE(CRC::LoadProfile(
+		"qCheck-CRC32-profile 2 OtherVendor"
+		+ Profile.substr(Profile.find('\n'))));
+	REQUIRE_FALSE(CRC::LoadProfile(Profile + "crc32 " + Kernel));
+
+	REQUIRE(CRC::LoadProfile(Profile));
+	CheckAll();
+}
+
+TEST_CASE("\'123456789\' CRC32C", "[CRC32C]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32C);
+	REQUIRE(Checksum == 0xE3069283);
+}
+
+TEST_CASE("mt19937_32x4096 CRC32C", "[CRC32C]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32C);
+	REQUIRE(Checksum == 0x9FC8405E);
+}
+
+TEST_CASE("mt19937_32x997 (byte) CRC32C", "[CRC32C]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32C);
+	REQUIRE(Checksum == 0xE5304C94);
+}
+
+TEST_CASE("mt19937_32x997 (byte) CRC32K", "[CRC32K]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32K);
+	REQUIRE(Checksum == 0x4CBD79BF);
+}
+
+TEST_CASE("mt19937_32x997 (byte) CRC32K2", "[CRC32K2]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32K2);
+	REQUIRE(Checksum == 0xCDD720CB);
+}
+
+TEST_CASE("mt19937_32x997 (byte) CRC32Q", "[CRC32Q]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint32_t Checksum = CRC::Checksum(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial::CRC32Q);
+	REQUIRE(Checksum == 0x9A3651C6);
 }
 
 TEST_CASE("Benchmarks", "[CRC32]")
@@ -0,0 +1,189 @@
+#include <CRC/CRC64.hpp>
+
+#include <array>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Null bytes", "[CRC64]")
+{
+	std::array<std::uint8_t, 0> Data;
+
+	const std::uint64_t Checksum
+		= CRC::Checksum64(std::as_bytes(std::span{Data}));
+	REQUIRE(Checksum == 0x0000000000000000);
+}
+
+TEST_CASE("\'123456789\' ECMA182", "[ECMA182]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::ECMA182);
+	REQUIRE(Checksum == 0x995DC9BBDF1939FA);
+}
+
+TEST_CASE("mt19937_32x4096 ECMA182", "[ECMA182]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::ECMA182);
+	REQUIRE(Checksum == 0xA69B33FCD5498A2C);
+}
+
+TEST_CASE("mt19937_32x997 (byte) ECMA182", "[ECMA182]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::ECMA182);
+	REQUIRE(Checksum == 0x35B29C2E6B5DDD02);
+}
+
+TEST_CASE("\'123456789\' NVMe", "[NVMe]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::NVMe);
+	REQUIRE(Checksum == 0xAE8B14860A799888);
+}
+
+TEST_CASE("mt19937_32x4096 NVMe", "[NVMe]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::NVMe);
+	REQUIRE(Checksum == 0xF3DF5E9E76D59320);
+}
+
+TEST_CASE("mt19937_32x997 (byte) NVMe", "[NVMe]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const std::uint64_t Checksum = CRC::Checksum64(
+		std::as_bytes(std::span{Data}), 0, CRC::Polynomial64::NVMe);
+	REQUIRE(Checksum == 0x08E5E660EA615604);
+}
+
+TEST_CASE("mt19937_32x997 (byte) Short and unaligned", "[CRC64]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 997> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const CRC::Polynomial64 CurPoly :
+		 {CRC::Polynomial64::ECMA182, CRC::Polynomial64::NVMe} )
+	{
+		// Every length around the block sizes of the folding kernels, from an
+		// unaligned offset, against the byte-at-a-time checksum
+		std::uint64_t Expected = 0;
+		for( std::size_t Length = 0; Length < 160; ++Length )
+		{
+			REQUIRE(
+				CRC::Checksum64(Bytes.subspan(1, Length), 0, CurPoly)
+				== Expected);
+			Expected = CRC::Checksum64(
+				Bytes.subspan(1 + Length, 1), Expected, CurPoly);
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x1024x2 Combine", "[CRC64]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 2048> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes  = std::as_bytes(std::span{Data});
+	const auto BytesA = Bytes.first(1024 * 4);
+	const auto BytesB = Bytes.last(1024 * 4);
+
+	for( const CRC::Polynomial64 CurPoly :
+		 {CRC::Polynomial64::ECMA182, CRC::Polynomial64::NVMe} )
+	{
+		const std::uint64_t ChecksumA = CRC::Checksum64(BytesA, 0, CurPoly);
+		const std::uint64_t ChecksumB = CRC::Checksum64(BytesB, 0, CurPoly);
+
+		REQUIRE(
+			CRC::Combine64(ChecksumA, ChecksumB, BytesB.size(), CurPoly)
+			== CRC::Checksum64(Bytes, 0, CurPoly));
+	}
+}
+
+TEST_CASE("Benchmarks", "[CRC64]")
+{
+	BENCHMARK_ADVANCED("1024")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024);
+		meter.measure([&Data]() {
+			return CRC::Checksum64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096);
+		meter.measure([&Data]() {
+			return CRC::Checksum64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("1MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024);
+		meter.measure([&Data]() {
+			return CRC::Checksum64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("10MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024 * 10);
+		meter.measure([&Data]() {
+			return CRC::Checksum64(std::as_bytes(std::span{Data}));
+		});
+	};
+}
@@ -0,0 +1,245 @@
+#include <MD5/MD5.hpp>
+
+#include <array>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+static constexpr MD5::Digest128 ParseDigest(std::string_view Hex)
+{
+	const auto Nibble = [](char Digit) -> std::uint8_t {
+		return Digit <= '9' ? Digit - '0' : Digit - 'a' + 10;
+	};
+
+	MD5::Digest128 Digest = {};
+	for( std::size_t i = 0; i < Digest.size(); ++i )
+	{
+		Digest[i] = (Nibble(Hex[i * 2]) << 4) | Nibble(Hex[i * 2 + 1]);
+	}
+	return Digest;
+}
+
+TEST_CASE("Null bytes", "[MD5]")
+{
+	std::array<std::uint8_t, 0> Data;
+
+	REQUIRE(
+		MD5::Hash(std::as_bytes(std::span{Data}))
+		== ParseDigest("d41d8cd98f00b204e9800998ecf8427e"));
+}
+
+TEST_CASE("\'123456789\'", "[MD5]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	REQUIRE(
+		MD5::Hash(std::as_bytes(std::span{Data}))
+		== ParseDigest("25f9e794323b453885f5181f1b624d0b"));
+}
+
+// The test suite of RFC 1321, appendix A.5
+TEST_CASE("RFC 1321", "[MD5]")
+{
+	struct TestVector
+	{
+		std::string_view Message;
+		MD5::Digest128   Hash;
+	};
+
+	static constexpr TestVector TestVectors[] = {
+		{"", ParseDigest("d41d8cd98f00b204e9800998ecf8427e")},
+		{"a", ParseDigest("0cc175b9c0f1b6a831c399e269772661")},
+		{"abc", ParseDigest("900150983cd24fb0d6963f7d28e17f72")},
+		{"message digest", ParseDigest("f96b697d7cb7938d525a2f31aaf161d0")},
+		{"abcdefghijklmnopqrstuvwxyz",
+		 ParseDigest("c3fcd3d76192e4007dfb496cca67e13b")},
+		{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+		 ParseDigest("d174ab98d277d9f5a5611c2c9f419d9f")},
+		{"1234567890123456789012345678901234567890"
+		 "1234567890123456789012345678901234567890",
+		 ParseDigest("57edf4a22be3c955ac49da2e2107b67a")},
+	};
+
+	for( const TestVector& CurVector : TestVectors )
+	{
+		REQUIRE(
+			MD5::Hash(std::as_bytes(std::span{CurVector.Message}))
+			== CurVector.Hash);
+	}
+}
+
+TEST_CASE("mt19937_32x4096", "[MD5]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	REQUIRE(
+		MD5::Hash(std::as_bytes(std::span{Data}))
+		== ParseDigest("3757c90f5f8450cdbf1f96ab8a1dadd7"));
+}
+
+struct LengthHash
+{
+	std::size_t    Length;
+	MD5::Digest128 Hash;
+};
+
+// Lengths on either side of where the padding spills into another block
+static constexpr LengthHash LengthHashes[] = {
+	{0, ParseDigest("d41d8cd98f00b204e9800998ecf8427e")},
+	{1, ParseDigest("28d397e87306b8631f3ed80d858d35f0")},
+	{3, ParseDigest("76f43f729aec866a3953676daf622bb2")},
+	{55, ParseDigest("2e4029d945ab7f13c8db07a3d5f0225d")},
+	{56, ParseDigest("49f1a2a10ae12834e6f7d9828ec3d24b")},
+	{63, ParseDigest("6655b3ab7b889730f8ea71c7efc200e6")},
+	{64, ParseDigest("a999d9519e04d93d7279d59cf39fd1dd")},
+	{65, ParseDigest("260825b9a19bc2545443af325edf710a")},
+	{119, ParseDigest("43202f60b4c8b26e5157c1246f4aa462")},
+	{120, ParseDigest("1d1e5a671a1bf81e9a2b1c020a4e0ced")},
+	{127, ParseDigest("81d5813d9d9ef1b520336e8a3cd5f805")},
+	{128, ParseDigest("98a7c7d2dcf8381bb5d2bf4affc0649b")},
+	{1000, ParseDigest("5f44c05da7b857c7bebb7a799288a2b9")},
+	{4095, ParseDigest("aec5b925beae5d80aea26fd00e9cb017")},
+	{8192, ParseDigest("b1bb9951bfe2d496d775bd067c96c276")},
+};
+
+TEST_CASE("mt19937_32x8192 (byte) Lengths", "[MD5]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		REQUIRE(MD5::Hash(Bytes.first(CurHash.Length)) == CurHash.Hash);
+	}
+}
+
+TEST_CASE("mt19937_32x8192 (byte) Hasher", "[MD5]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		// Chunk sizes that leave partial blocks behind between updates
+		for( const std::size_t ChunkSize : {1, 7, 63, 64, 65, 1000, 8192} )
+		{
+			MD5::Hasher Hasher;
+
+			const auto Input = Bytes.first(CurHash.Length);
+			for( std::size_t i = 0; i < Input.size(); i += ChunkSize )
+			{
+				Hasher.Update(
+					Input.subspan(i, std::min(ChunkSize, Input.size() - i)));
+			}
+
+			REQUIRE(Hasher.Finalize() == CurHash.Hash);
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x8192 (byte) Multi-buffer", "[MD5]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	// More inputs than there are lanes, of all different lengths, so that
+	// lanes finish at different times and are refilled with later inputs
+	std::vector<std::span<const std::byte>> Inputs;
+	std::vector<MD5::Digest128>             Expected;
+	for( std::size_t i = 0; i < 3; ++i )
+	{
+		for( const LengthHash& CurHash : LengthHashes )
+		{
+			Inputs.push_back(Bytes.first(CurHash.Length));
+			Expected.push_back(CurHash.Hash);
+		}
+	}
+
+	for( std::size_t Count = 0; Count <= Inputs.size(); ++Count )
+	{
+		std::vector<MD5::Digest128> Digests(Count);
+		MD5::Hash(std::span(Inputs).first(Count), Digests);
+
+		for( std::size_t i = 0; i < Count; ++i )
+		{
+			REQUIRE(Digests[i] == Expected[i]);
+		}
+	}
+}
+
+TEST_CASE("Benchmarks", "[MD5]")
+{
+	BENCHMARK_ADVANCED("1024")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024);
+		meter.measure([&Data]() {
+			return MD5::Hash(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096);
+		meter.measure([&Data]() {
+			return MD5::Hash(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("1MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024);
+		meter.measure([&Data]() {
+			return MD5::Hash(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("16 x 4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096 * 16);
+
+		std::array<std::span<const std::byte>, 16> Inputs;
+		for( std::size_t i = 0; i < Inputs.size(); ++i )
+		{
+			Inputs[i] = std::as_bytes(std::span{Data}.subspan(i * 4096, 4096));
+		}
+		std::array<MD5::Digest128, 16> Digests;
+
+		meter.measure([&Inputs, &Digests]() {
+			MD5::Hash(Inputs, Digests);
+			return Digests[0];
+		});
+	};
+}
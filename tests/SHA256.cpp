@@ -0,0 +1,255 @@
+#include <SHA/SHA256.hpp>
+
+#include <array>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+static constexpr SHA::Digest256 ParseDigest(std::string_view Hex)
+{
+	const auto Nibble = [](char Digit) -> std::uint8_t {
+		return Digit <= '9' ? Digit - '0' : Digit - 'a' + 10;
+	};
+
+	SHA::Digest256 Digest = {};
+	for( std::size_t i = 0; i < Digest.size(); ++i )
+	{
+		Digest[i] = (Nibble(Hex[i * 2]) << 4) | Nibble(Hex[i * 2 + 1]);
+	}
+	return Digest;
+}
+
+TEST_CASE("Null bytes", "[SHA256]")
+{
+	std::array<std::uint8_t, 0> Data;
+
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{Data}))
+		== ParseDigest("e3b0c44298fc1c149afbf4c8996fb924"
+					   "27ae41e4649b934ca495991b7852b855"));
+}
+
+TEST_CASE("\'123456789\'", "[SHA256]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{Data}))
+		== ParseDigest("15e2b0d3c33891ebb0f1ef609ec41942"
+					   "0c20e320ce94c65fbc8c3312448eb225"));
+}
+
+// The examples of FIPS 180-2, appendix B
+TEST_CASE("FIPS 180-2", "[SHA256]")
+{
+	const auto OneBlock = std::string_view("abc");
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{OneBlock}))
+		== ParseDigest("ba7816bf8f01cfea414140de5dae2223"
+					   "b00361a396177a9cb410ff61f20015ad"));
+
+	const auto TwoBlocks = std::string_view(
+		"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{TwoBlocks}))
+		== ParseDigest("248d6a61d20638b8e5c026930c3e6039"
+					   "a33ce45964ff2167f6ecedd419db06c1"));
+
+	const std::string Million(1'000'000, 'a');
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{Million}))
+		== ParseDigest("cdc76e5c9914fb9281a1c7e284d73e67"
+					   "f1809a48a497200e046d39ccc7112cd0"));
+}
+
+TEST_CASE("mt19937_32x4096", "[SHA256]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	REQUIRE(
+		SHA::Hash256(std::as_bytes(std::span{Data}))
+		== ParseDigest("a201b335cf5a49fba2f8e134b2fb13c7"
+					   "11ccc3b13604980b478f03057e13b2e0"));
+}
+
+struct LengthHash
+{
+	std::size_t    Length;
+	SHA::Digest256 Hash;
+};
+
+// Lengths on either side of where the padding spills into another block
+static constexpr LengthHash LengthHashes[] = {
+	{0, ParseDigest("e3b0c44298fc1c149afbf4c8996fb924"
+					"27ae41e4649b934ca495991b7852b855")},
+	{1, ParseDigest("a9253dc8529dd214e5f22397888e78d3"
+					"390daa47593e26f68c18f97fd7a3876b")},
+	{3, ParseDigest("389f078b1dbed592c214d3ca72b32edd"
+					"deaf32702f80d1c5a94dd43ca060c3d6")},
+	{55, ParseDigest("2fc4d354a3a39e4076153cc20e8b4cd5"
+					 "a70dfdcdab4aca0113b77eab0666ea75")},
+	{56, ParseDigest("3f2bde6b21d64a9c904a6d6dc8252365"
+					 "e08d60786cf49718c501265c790d948a")},
+	{63, ParseDigest("69dedc919b9decc4b1f5f29d1155081b"
+					 "73519d087a322cdee2c1391a26e85e05")},
+	{64, ParseDigest("a8156f5cacbae417b26ace5efc6b6511"
+					 "c347867a3def8037d2bb74fa41e25374")},
+	{65, ParseDigest("9e8e8c37ee0dfaedc708f1622e23b8c5"
+					 "080b02c0f9bdb8fe030c67f4fd25a900")},
+	{119, ParseDigest("58a8bfe91d71190eb8480ae4fd1f848d"
+					  "db9cc805fd160c46cf953926312999c7")},
+	{120, ParseDigest("09d0f9c6c595d68b4954e6ac4686a55e"
+					  "8090fbfd1bc20ba9fa9c74a620c20136")},
+	{127, ParseDigest("91bce5e727af8123b3a082692e61b084"
+					  "80fcf4c956290a54a8417395e28d536b")},
+	{128, ParseDigest("ab36341a5e6148de7357946f0af1f360"
+					  "8e3b361bd4b949fd4e7fe029eed56296")},
+	{1000, ParseDigest("e294ce80f7d2e7ddcad2ccbfd456373a"
+					   "64a85fc44a43a1f5b0f7747a878043eb")},
+	{4095, ParseDigest("f9c135fe0dcc5e3b74849840d0d9e55d"
+					   "d56d82be38f5858f3f43eaa61f3a27ae")},
+	{8192, ParseDigest("482b3eec248229dbfbed785f4f96f47f"
+					   "33a9213a843353d3effd73176a947e88")},
+};
+
+TEST_CASE("mt19937_32x8192 (byte) Lengths", "[SHA256]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		REQUIRE(SHA::Hash256(Bytes.first(CurHash.Length)) == CurHash.Hash);
+	}
+}
+
+TEST_CASE("mt19937_32x8192 (byte) Hasher", "[SHA256]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		// Chunk sizes that leave partial blocks behind between updates
+		for( const std::size_t ChunkSize : {1, 7, 63, 64, 65, 1000, 8192} )
+		{
+			SHA::Hasher Hasher;
+
+			const auto Input = Bytes.first(CurHash.Length);
+			for( std::size_t i = 0; i < Input.size(); i += ChunkSize )
+			{
+				Hasher.Update(
+					Input.subspan(i, std::min(ChunkSize, Input.size() - i)));
+			}
+
+			REQUIRE(Hasher.Finalize() == CurHash.Hash);
+		}
+	}
+}
+
+TEST_CASE("mt19937_32x8192 (byte) Multi-buffer", "[SHA256]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	// More inputs than there are lanes, of all different lengths, so that
+	// lanes finish at different times and are refilled with later inputs
+	std::vector<std::span<const std::byte>> Inputs;
+	std::vector<SHA::Digest256>             Expected;
+	for( std::size_t i = 0; i < 3; ++i )
+	{
+		for( const LengthHash& CurHash : LengthHashes )
+		{
+			Inputs.push_back(Bytes.first(CurHash.Length));
+			Expected.push_back(CurHash.Hash);
+		}
+	}
+
+	for( std::size_t Count = 0; Count <= Inputs.size(); ++Count )
+	{
+		std::vector<SHA::Digest256> Digests(Count);
+		SHA::Hash256(std::span(Inputs).first(Count), Digests);
+
+		for( std::size_t i = 0; i < Count; ++i )
+		{
+			REQUIRE(Digests[i] == Expected[i]);
+		}
+	}
+}
+
+TEST_CASE("Benchmarks", "[SHA256]")
+{
+	BENCHMARK_ADVANCED("1024")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024);
+		meter.measure([&Data]() {
+			return SHA::Hash256(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096);
+		meter.measure([&Data]() {
+			return SHA::Hash256(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("1MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024);
+		meter.measure([&Data]() {
+			return SHA::Hash256(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("16 x 4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096 * 16);
+
+		std::array<std::span<const std::byte>, 16> Inputs;
+		for( std::size_t i = 0; i < Inputs.size(); ++i )
+		{
+			Inputs[i] = std::as_bytes(std::span{Data}.subspan(i * 4096, 4096));
+		}
+		std::array<SHA::Digest256, 16> Digests;
+
+		meter.measure([&Inputs, &Digests]() {
+			SHA::Hash256(Inputs, Digests);
+			return Digests[0];
+		});
+	};
+}
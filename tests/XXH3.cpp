@@ -0,0 +1,174 @@
+#include <XXH/XXH3.hpp>
+
+#include <array>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Null bytes", "[XXH3]")
+{
+	std::array<std::uint8_t, 0> Data;
+
+	REQUIRE(XXH::Hash64(std::as_bytes(std::span{Data})) == 0x2D06800538D394C2);
+	REQUIRE(
+		XXH::Hash128(std::as_bytes(std::span{Data}))
+		== XXH::Digest128{0x6001C324468D497F, 0x99AA06D3014798D8});
+}
+
+TEST_CASE("\'123456789\'", "[XXH3]")
+{
+	const char String[] = "123456789";
+	const auto Data     = std::string_view(String);
+
+	REQUIRE(XXH::Hash64(std::as_bytes(std::span{Data})) == 0x72DCB18B67A17DFF);
+	REQUIRE(
+		XXH::Hash128(std::as_bytes(std::span{Data}))
+		== XXH::Digest128{0xE9716427681D5860, 0x33119477EDE5DCD5});
+}
+
+TEST_CASE("mt19937_32x4096", "[XXH3]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint32_t, 4096> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	REQUIRE(XXH::Hash64(std::as_bytes(std::span{Data})) == 0x5BF70CDD090E7DB1);
+	REQUIRE(
+		XXH::Hash128(std::as_bytes(std::span{Data}))
+		== XXH::Digest128{0x5BF70CDD090E7DB1, 0x55D94EEC7C271258});
+}
+
+struct LengthHash
+{
+	std::size_t    Length;
+	std::uint64_t  Hash64;
+	XXH::Digest128 Hash128;
+};
+
+// Lengths on either side of each of the size classes of the algorithm
+static constexpr LengthHash LengthHashes[] = {
+	{0, 0x2D06800538D394C2, {0x6001C324468D497F, 0x99AA06D3014798D8}},
+	{1, 0xFDBB701539A22AA6, {0xFDBB701539A22AA6, 0x61088B7D92606626}},
+	{2, 0x0C2B4F38EF675FC3, {0x0C2B4F38EF675FC3, 0xC79E37F7D1D22931}},
+	{3, 0x5E4CBC0B4C4BD899, {0x5E4CBC0B4C4BD899, 0xE76E1CE64C4AAF2D}},
+	{4, 0x32A696F4AA428675, {0xC09D9A7C39F414E4, 0x23199BCB70C736DF}},
+	{7, 0xB4E607A2A86B8205, {0xD7CD5B237A719FD5, 0xFF6B08F55B38778C}},
+	{8, 0x15EBCD1335D3EF4B, {0x9599E98B6B5C8BA8, 0x84F9B89FDC3222C1}},
+	{9, 0x46B7F4D0638A59B0, {0xF7514C922731FD7B, 0x8838FE75034FF2EF}},
+	{16, 0xDC03588D2CC83805, {0x6E38FCB0B75A2AC6, 0x916B5B026AEBD540}},
+	{17, 0xBD81FE800F78DFF9, {0x087C5021A547F7A4, 0x7FBCFA18E729124A}},
+	{32, 0x613F50D5BB28EAA5, {0x48D127080BAF4D77, 0xDE15CC42630478B4}},
+	{33, 0x9E812E32383223F0, {0x8364B09A22C46E61, 0xB456D6BEA600714F}},
+	{64, 0x480BE33CBF90F349, {0xBECEB01DCA1D07AF, 0x7FCFE6F92A5D1940}},
+	{65, 0x2ADCE9ACD73F822D, {0x1A5D928A55C2B53C, 0x2395F9CFB29F3B1A}},
+	{96, 0xDDBD34037EE3E176, {0xA7D48B69315CCFA5, 0x31B50554F6ADDE8D}},
+	{97, 0xCF1DDB7FBF269DA7, {0x5FA27A32D6FC2298, 0x03B042E8728CD0D7}},
+	{128, 0x60747A28D90C5D08, {0x4F25D6534C3EC201, 0x64C5EC2D7D41FE89}},
+	{129, 0xC7185319A1AAEAEE, {0x8BB3BEC2D0F2A822, 0x2C12AD4E1A163827}},
+	{200, 0x7E63C5899F0D086A, {0x17C34D074427871E, 0xC915549CDE634A3F}},
+	{240, 0xD822C61C4C9A0A8C, {0x7210E5C4C903D3F6, 0x116C6B43A1EAFCD9}},
+	{241, 0xDB10BE1D61DF543F, {0xDB10BE1D61DF543F, 0x2D5E70DB641FC68E}},
+	{256, 0x56CF5C7B1722A712, {0x56CF5C7B1722A712, 0x63600BD8B5E443C5}},
+	{1023, 0xABABD6EBAF358762, {0xABABD6EBAF358762, 0x35B4F467EBE567E5}},
+	{1024, 0x2A7698B9173F23EA, {0x2A7698B9173F23EA, 0x9B5A209245A123E5}},
+	{1025, 0xBE0D6C6451609037, {0xBE0D6C6451609037, 0xA61764E57A74C360}},
+	{2048, 0x18FA85CDB5A9A467, {0x18FA85CDB5A9A467, 0x74967EEA4F4AAC30}},
+	{4095, 0x1724BEC0FA0AF0D3, {0x1724BEC0FA0AF0D3, 0x699D3F10B9EBFEF8}},
+	{8192, 0x5E9553D94E3862C4, {0x5E9553D94E3862C4, 0xD0C2B89F4AA6304A}},
+};
+
+TEST_CASE("mt19937_32x8192 (byte) Lengths", "[XXH3]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		REQUIRE(XXH::Hash64(Bytes.first(CurHash.Length)) == CurHash.Hash64);
+		REQUIRE(XXH::Hash128(Bytes.first(CurHash.Length)) == CurHash.Hash128);
+	}
+}
+
+TEST_CASE("mt19937_32x8192 (byte) Hasher", "[XXH3]")
+{
+	std::mt19937 MersenneTwister;
+
+	std::array<std::uint8_t, 8192> Data = {};
+	for( auto& CurValue : Data )
+	{
+		CurValue = MersenneTwister();
+	}
+
+	const auto Bytes = std::as_bytes(std::span{Data});
+
+	for( const LengthHash& CurHash : LengthHashes )
+	{
+		// Chunk sizes that leave partial stripes and blocks behind between
+		// updates
+		for( const std::size_t ChunkSize :
+			 {1, 7, 63, 64, 65, 255, 256, 257, 1000, 8192} )
+		{
+			XXH::Hasher Hasher;
+
+			const auto Input = Bytes.first(CurHash.Length);
+			for( std::size_t i = 0; i < Input.size(); i += ChunkSize )
+			{
+				Hasher.Update(
+					Input.subspan(i, std::min(ChunkSize, Input.size() - i)));
+			}
+
+			REQUIRE(Hasher.Finalize64() == CurHash.Hash64);
+			REQUIRE(Hasher.Finalize128() == CurHash.Hash128);
+		}
+	}
+}
+
+TEST_CASE("Benchmarks", "[XXH3]")
+{
+	BENCHMARK_ADVANCED("1024")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024);
+		meter.measure([&Data]() {
+			return XXH::Hash64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("4096")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(4096);
+		meter.measure([&Data]() {
+			return XXH::Hash64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("1MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024);
+		meter.measure([&Data]() {
+			return XXH::Hash64(std::as_bytes(std::span{Data}));
+		});
+	};
+
+	BENCHMARK_ADVANCED("10MiB")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<std::uint32_t> Data(1024ULL * 1024 * 10);
+		meter.measure([&Data]() {
+			return XXH::Hash64(std::as_bytes(std::span{Data}));
+		});
+	};
+}